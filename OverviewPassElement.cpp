@@ -2,30 +2,31 @@
 #include "overview.hpp"
 #include <hyprland/src/render/OpenGL.hpp>
 
-COverviewPassElement::COverviewPassElement() {}
+COverviewPassElement::COverviewPassElement(COverview* overview_)
+    : overview(overview_) {}
 
 void COverviewPassElement::draw(const CRegion &damage) {
-  if (!g_pOverview)
+  if (!overviewAlive(overview))
     return;
-  g_pOverview->fullRender();
+  overview->fullRender();
 }
 
 bool COverviewPassElement::needsLiveBlur() { return false; }
 bool COverviewPassElement::needsPrecomputeBlur() { return false; }
 
 std::optional<CBox> COverviewPassElement::boundingBox() {
-  if (!g_pOverview)
+  if (!overviewAlive(overview))
     return std::nullopt;
-  const auto mon = g_pOverview->pMonitor.lock();
+  const auto mon = overview->pMonitor.lock();
   if (!mon)
     return std::nullopt;
   return CBox{{}, mon->m_size};
 }
 
 CRegion COverviewPassElement::opaqueRegion() {
-  if (!g_pOverview)
+  if (!overviewAlive(overview))
     return CRegion{};
-  const auto mon = g_pOverview->pMonitor.lock();
+  const auto mon = overview->pMonitor.lock();
   if (!mon)
     return CRegion{};
   return CBox{{}, mon->m_size};
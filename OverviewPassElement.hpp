@@ -1,9 +1,11 @@
 #pragma once
 #include <hyprland/src/render/pass/PassElement.hpp>
 
+class COverview;
+
 class COverviewPassElement : public IPassElement {
 public:
-  COverviewPassElement();
+  explicit COverviewPassElement(COverview* overview_);
 
   virtual void draw(const CRegion &damage) override;
   virtual bool needsLiveBlur() override;
@@ -11,4 +13,7 @@ public:
   virtual std::optional<CBox> boundingBox() override;
   virtual CRegion opaqueRegion() override;
   virtual const char *passName() override { return "COverviewPassElement"; }
+
+private:
+  COverview* overview = nullptr;
 };
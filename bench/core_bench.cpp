@@ -0,0 +1,154 @@
+// Micro-benchmarks for horza_core. Prints one JSON object per benchmark:
+//   horza_core_bench [filter]
+#include "core/capture_schedule.hpp"
+#include "core/compositor_view.hpp"
+#include "core/config_parse.hpp"
+#include "core/layout.hpp"
+#include "core/tile_cache.hpp"
+#include "core/workspace_reconcile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Keeps the optimizer from discarding benchmark results.
+volatile int64_t g_sink = 0;
+void sink(int64_t v) { g_sink = g_sink + v; }
+
+template <typename Fn>
+void runBench(const char* filter, const char* name, int iterations, Fn&& fn) {
+  if (filter && !std::strstr(name, filter))
+    return;
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  fn(); // warm-up
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = Clock::now();
+    fn();
+    samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start)
+                          .count());
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto pct = [&](double p) {
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+  };
+  std::printf("{\"bench\": \"%s\", \"iterations\": %d, \"p50_us\": %.3f, "
+              "\"p95_us\": %.3f, \"min_us\": %.3f}\n",
+              name, iterations, pct(0.50), pct(0.95), samples.front());
+}
+
+SStripLayoutParams stripParams(int currentIdx) {
+  return {.monitorW = 2560.0,
+          .monitorH = 1440.0,
+          .scale = 0.6f,
+          .displayScale = 0.6f,
+          .gap = 20.0f,
+          .inactiveScale = 0.85f,
+          .currentIdx = currentIdx};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const char* filter = argc > 1 ? argv[1] : nullptr;
+  std::mt19937 rng(42);
+
+  runBench(filter, "layout_1000_cards", 2000, [] {
+    const auto layout = computeStripLayout(stripParams(500));
+    for (int i = 0; i < 1000; ++i) {
+      const auto r = stripCardRect(layout, i);
+      sink(cardRectOnScreen(r, 2560.0, 1440.0));
+    }
+  });
+
+  {
+    const auto layout = computeStripLayout(stripParams(500));
+    std::vector<SCardRect> rects(1000);
+    for (int i = 0; i < 1000; ++i)
+      rects[i] = stripCardRect(layout, i);
+    runBench(filter, "hit_test_1000_cards", 2000, [&] {
+      for (int x = 0; x < 2560; x += 16)
+        sink(hitStripCard(layout, 1000, x, 720.0,
+                               [&](int i) -> const SCardRect& { return rects[i]; }));
+    });
+  }
+
+  {
+    CTileCache<int> cache;
+    const auto now = std::chrono::steady_clock::now();
+    runBench(filter, "cache_prune_10k_to_96", 200, [&] {
+      for (int i = 0; i < 10000; ++i)
+        cache.store({0, i}, i, now, now - std::chrono::milliseconds(rng() % 4000));
+      sink(cache.prune(now, std::chrono::seconds(5), 96,
+                            [](int) { return true; }));
+    });
+  }
+
+  {
+    CTileCache<int> cache;
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10000; ++i)
+      cache.store({i % 4, i}, i, now, now);
+    runBench(filter, "cache_prune_10k_steady", 500, [&] {
+      sink(cache.prune(now, std::chrono::seconds(5), 20000,
+                            [](int) { return true; }));
+    });
+  }
+
+  {
+    CStubCompositorView view;
+    view.activeByMonitor = {3, 10};
+    for (int i = 1; i <= 1000; ++i)
+      view.workspaces.push_back({.id = i, .monitorID = i % 2});
+    std::vector<int64_t> ids;
+    runBench(filter, "collect_workspaces_1000", 2000, [&] {
+      collectMonitorWorkspaceIDs(view, 0, ids);
+      sink((int64_t)ids.size());
+    });
+
+    collectMonitorWorkspaceIDs(view, 0, ids);
+    std::vector<int64_t> oldIDs = ids;
+    std::vector<int64_t> newIDs = ids;
+    newIDs.erase(newIDs.begin() + newIDs.size() / 2);
+    newIDs.push_back(5000); // stays sorted
+    runBench(filter, "reconcile_500_workspaces", 500, [&] {
+      const auto plan = reconcileWorkspaceList(oldIDs, newIDs, oldIDs[250], 10, 250);
+      sink(plan.currentIdx);
+    });
+  }
+
+  {
+    std::vector<SCardCaptureState> states(1000);
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i)
+      states[i] = {.captured = i % 7 != 0,
+                   .onScreen = std::abs(i - 500) < 4,
+                   .lastCaptureAt = now - std::chrono::milliseconds(i)};
+    const auto stateOf = [&](int i) { return states[i]; };
+    runBench(filter, "capture_pick_1000_cards", 2000, [&] {
+      sink(pickNearestUncapturedCard(1000, 500, 1000, stateOf));
+      sink(pickLivePreviewCard(1000, 500, 3, 60.0f, now, stateOf));
+    });
+  }
+
+  runBench(filter, "config_parse_tokens", 2000, [] {
+    std::string out;
+    bool b = false;
+    for (const char* raw : {" True ", "false", "RGB565", "argb8888", "Texture", "bogus"}) {
+      sink(parseStrictBool(raw, b));
+      sink(parseCaptureFormat(raw, out));
+      sink(parseCardShadowMode(raw, out));
+    }
+  });
+
+  return 0;
+}
@@ -0,0 +1,360 @@
+#!/usr/bin/env python3
+"""Headless end-to-end benchmark for horza.
+
+Starts a throwaway Hyprland instance on the headless backend with software GL,
+creates workspaces with dummy clients, loads libhorza.so and drives the
+overview through hyprctl. Counters are read back from `hyprctl -j horza stats`
+after every phase and written as one JSON document, so two runs can be diffed
+for regressions.
+"""
+
+import argparse
+import datetime
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HYPRLAND_CONFIG = """
+monitor = , {width}x{height}@{refresh}, 0x0, 1
+misc {{
+  disable_hyprland_logo = true
+  disable_splash_rendering = true
+}}
+debug {{
+  disable_logs = false
+}}
+"""
+
+
+def log(msg):
+    print(f"[horza_bench] {msg}", file=sys.stderr, flush=True)
+
+
+class Hyprland:
+    def __init__(self, args, workdir):
+        self.args = args
+        self.workdir = workdir
+        self.proc = None
+        self.output = None
+        self.signature = None
+
+    def start(self):
+        runtime = os.environ.get("XDG_RUNTIME_DIR")
+        if not runtime:
+            raise RuntimeError("XDG_RUNTIME_DIR is not set")
+        hypr_dir = os.path.join(runtime, "hypr")
+        before = set(os.listdir(hypr_dir)) if os.path.isdir(hypr_dir) else set()
+
+        config = os.path.join(self.workdir, "hyprland.conf")
+        with open(config, "w") as f:
+            f.write(HYPRLAND_CONFIG.format(width=self.args.width,
+                                           height=self.args.height,
+                                           refresh=self.args.refresh))
+
+        env = dict(os.environ)
+        env.update({
+            "HYPRLAND_HEADLESS_ONLY": "1",
+            "LIBGL_ALWAYS_SOFTWARE": "1",
+            "WLR_RENDERER_ALLOW_SOFTWARE": "1",
+        })
+        env.pop("WAYLAND_DISPLAY", None)
+        env.pop("HYPRLAND_INSTANCE_SIGNATURE", None)
+
+        self.output = open(os.path.join(self.workdir, "hyprland.out"), "w")
+        self.proc = subprocess.Popen(
+            [self.args.hyprland, "--config", config],
+            env=env,
+            stdout=self.output,
+            stderr=subprocess.STDOUT,
+        )
+
+        deadline = time.monotonic() + self.args.startup_timeout
+        while time.monotonic() < deadline:
+            if self.proc.poll() is not None:
+                raise RuntimeError(
+                    f"Hyprland exited with {self.proc.returncode}, "
+                    f"see hyprland.out (rerun with --keep-workdir)")
+            if os.path.isdir(hypr_dir):
+                fresh = set(os.listdir(hypr_dir)) - before
+                for sig in fresh:
+                    sock = os.path.join(hypr_dir, sig, ".socket.sock")
+                    if os.path.exists(sock):
+                        self.signature = sig
+                        break
+            if self.signature and self.ctl("version").returncode == 0:
+                break
+            time.sleep(0.1)
+        else:
+            raise RuntimeError("timed out waiting for the Hyprland socket")
+
+        if not json.loads(self.ctl("monitors", json_out=True).stdout or "[]"):
+            self.ctl("output", "create", "headless")
+            time.sleep(0.5)
+        log(f"Hyprland up, instance {self.signature}")
+
+    def ctl(self, *cmd, json_out=False, check=False):
+        argv = [self.args.hyprctl, "-i", self.signature]
+        if json_out:
+            argv.append("-j")
+        argv += list(cmd)
+        res = subprocess.run(argv, capture_output=True, text=True)
+        if check and (res.returncode != 0 or "error" in res.stdout.lower()):
+            raise RuntimeError(f"hyprctl {' '.join(cmd)}: {res.stdout}{res.stderr}")
+        return res
+
+    def dispatch(self, *cmd):
+        return self.ctl("dispatch", *cmd)
+
+    def batch(self, commands):
+        return self.ctl("--batch", " ; ".join(commands))
+
+    def stop(self):
+        if self.output:
+            self.output.close()
+            self.output = None
+        if not self.proc:
+            return
+        if self.proc.poll() is None and self.signature:
+            self.dispatch("exit")
+            try:
+                self.proc.wait(timeout=5)
+            except subprocess.TimeoutExpired:
+                pass
+        if self.proc.poll() is None:
+            self.proc.terminate()
+            try:
+                self.proc.wait(timeout=5)
+            except subprocess.TimeoutExpired:
+                self.proc.kill()
+
+
+def hyprland_version(hypr):
+    try:
+        return json.loads(hypr.ctl("version", json_out=True).stdout).get("tag")
+    except json.JSONDecodeError:
+        return None
+
+
+def read_stats(hypr):
+    res = hypr.ctl("horza", "stats", json_out=True)
+    try:
+        return json.loads(res.stdout)
+    except json.JSONDecodeError:
+        raise RuntimeError(f"unexpected horza stats output: {res.stdout!r}")
+
+
+def run_phase(hypr, name, body):
+    hypr.ctl("horza", "stats", "reset")
+    started = time.monotonic()
+    body()
+    # Let trailing frames and captures land before sampling.
+    time.sleep(0.3)
+    stats = read_stats(hypr)
+    stats["wall_s"] = round(time.monotonic() - started, 3)
+    log(f"phase {name} done in {stats['wall_s']}s")
+    return stats
+
+
+def populate(hypr, args):
+    client = args.client
+    if client and not shutil.which(client.split()[0]):
+        log(f"client '{client}' not found, workspaces stay empty")
+        client = None
+
+    for ws in range(1, args.workspaces + 1):
+        hypr.dispatch("workspace", str(ws))
+        if client:
+            for _ in range(args.clients_per_workspace):
+                hypr.dispatch("exec", f"[workspace {ws} silent] {client}")
+    hypr.dispatch("workspace", "1")
+    time.sleep(args.settle)
+
+
+def run_phases(hypr, args):
+    def open_close():
+        for _ in range(args.iterations):
+            hypr.dispatch("horza:toggle")
+            time.sleep(args.interval)
+            hypr.dispatch("horza:toggle")
+            time.sleep(args.interval)
+
+    def switch():
+        hypr.dispatch("horza:toggle")
+        time.sleep(args.interval)
+        for i in range(args.iterations):
+            hypr.dispatch("horza:workspace",
+                          "+1" if (i // max(1, args.workspaces - 1)) % 2 == 0 else "-1")
+            time.sleep(args.interval)
+        hypr.dispatch("horza:toggle")
+
+    def scroll_burst():
+        # hyprctl cannot inject pointer axis events; a batch of workspace
+        # steps exercises the same per-step path back to back.
+        hypr.dispatch("horza:toggle")
+        time.sleep(args.interval)
+        steps = []
+        for i in range(args.scroll_steps):
+            forward = (i // max(1, args.workspaces - 1)) % 2 == 0
+            steps.append(f"dispatch horza:workspace {'+1' if forward else '-1'}")
+        hypr.batch(steps)
+        time.sleep(args.interval)
+        hypr.dispatch("horza:toggle")
+
+    return {
+        "open_close": run_phase(hypr, "open_close", open_close),
+        "switch": run_phase(hypr, "switch", switch),
+        "scroll_burst": run_phase(hypr, "scroll_burst", scroll_burst),
+    }
+
+
+def check_reduced_levels(phases, keywords):
+    """With downsample_cards on, every phase that captured cards must have
+    built reduced levels for them; returns the failed checks."""
+    enabled = False
+    for kv in keywords:
+        key, _, value = kv.partition("=")
+        if key == "downsample_cards":
+            enabled = value.strip().lower() in ("1", "true", "yes", "on")
+    if not enabled:
+        return []
+
+    failed = []
+    for name, stats in phases.items():
+        captures = stats.get("captures", {})
+        captured = (captures.get("workspace", {}).get("count", 0) +
+                    captures.get("presented_frame", 0))
+        if captured > 0 and captures.get("reduced_levels", 0) == 0:
+            failed.append(f"{name}: {captured} captures built no reduced level")
+    for msg in failed:
+        log(f"check failed: {msg}")
+    return failed
+
+
+def summarize(phases):
+    def pick(phase, *path):
+        node = phases.get(phase, {})
+        for key in path:
+            node = node.get(key, {}) if isinstance(node, dict) else {}
+        return node if node != {} else None
+
+    summary = {}
+    for label, phase, kind in (("open", "open_close", "open"),
+                               ("switch", "switch", "workspace_dispatch"),
+                               ("scroll_burst", "scroll_burst", "workspace_dispatch")):
+        for q in ("p50_ms", "p95_ms", "p99_ms"):
+            summary[f"{label}_latency_{q}"] = pick(phase, "latency", kind, q)
+    for phase in phases:
+        for q in ("p50_ms", "p95_ms"):
+            summary[f"{phase}_render_{q}"] = pick(phase, "frames", "render", q)
+            summary[f"{phase}_capture_{q}"] = pick(phase, "captures", "workspace", q)
+    return summary
+
+
+def run_session(args, plugin, workdir):
+    hypr = Hyprland(args, workdir)
+    report = {}
+    try:
+        hypr.start()
+        hypr.ctl("plugin", "load", plugin, check=True)
+        for kv in args.keyword:
+            key, _, value = kv.partition("=")
+            hypr.ctl("keyword", f"plugin:horza:{key}", value)
+        populate(hypr, args)
+
+        phases = run_phases(hypr, args)
+        checks = check_reduced_levels(phases, args.keyword)
+        compare = None
+        if args.compare:
+            # The same phases with the option off and then on, in one session.
+            compare = {"key": args.compare}
+            for label, value in (("off", "false"), ("on", "true")):
+                hypr.ctl("keyword", f"plugin:horza:{args.compare}", value)
+                compare_phases = run_phases(hypr, args)
+                compare[label] = summarize(compare_phases)
+                checks += check_reduced_levels(
+                    compare_phases, args.keyword + [f"{args.compare}={value}"])
+
+        report = {
+            "meta": {
+                "date": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+                "hyprland": hyprland_version(hypr),
+                "plugin": plugin,
+                "workspaces": args.workspaces,
+                "clients_per_workspace": args.clients_per_workspace,
+                "client": args.client,
+                "iterations": args.iterations,
+                "scroll_steps": args.scroll_steps,
+                "resolution": f"{args.width}x{args.height}@{args.refresh}",
+                "keywords": args.keyword,
+            },
+            "summary": summarize(phases),
+            "phases": phases,
+            "checks": checks,
+        }
+        if compare:
+            report["compare"] = compare
+    finally:
+        hypr.stop()
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--plugin", required=True, help="path to libhorza.so")
+    parser.add_argument("--output", help="write the JSON report here (default: stdout)")
+    parser.add_argument("--hyprland", default="Hyprland")
+    parser.add_argument("--hyprctl", default="hyprctl")
+    parser.add_argument("--workspaces", type=int, default=6)
+    parser.add_argument("--clients-per-workspace", type=int, default=2)
+    parser.add_argument("--client", default="foot",
+                        help="command used as a dummy client ('' for none)")
+    parser.add_argument("--iterations", type=int, default=20,
+                        help="open/close cycles and workspace switches per phase")
+    parser.add_argument("--scroll-steps", type=int, default=40)
+    parser.add_argument("--interval", type=float, default=0.25,
+                        help="seconds between driven actions")
+    parser.add_argument("--settle", type=float, default=1.0)
+    parser.add_argument("--startup-timeout", type=float, default=15.0)
+    parser.add_argument("--width", type=int, default=1920)
+    parser.add_argument("--height", type=int, default=1080)
+    parser.add_argument("--refresh", type=int, default=60)
+    parser.add_argument("--keep-workdir", action="store_true",
+                        help="keep the temporary Hyprland config and log")
+    parser.add_argument("--compare", metavar="KEY",
+                        help="rerun all phases with boolean option KEY off and on")
+    parser.add_argument("--keyword", action="append", default=[],
+                        metavar="KEY=VALUE",
+                        help="extra plugin option, e.g. capture_scale=0.5")
+    args = parser.parse_args()
+
+    plugin = os.path.abspath(args.plugin)
+    if not os.path.exists(plugin):
+        parser.error(f"{plugin} does not exist")
+
+    # The compositor is stopped and its workdir removed even when a phase
+    # fails, unless --keep-workdir asks to keep the logs.
+    workdir = tempfile.mkdtemp(prefix="horza-bench-")
+    try:
+        report = run_session(args, plugin, workdir)
+    finally:
+        if args.keep_workdir:
+            log(f"workdir kept at {workdir}")
+        else:
+            shutil.rmtree(workdir, ignore_errors=True)
+
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+        log(f"report written to {args.output}")
+    else:
+        print(text)
+    return 1 if report.get("checks") else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
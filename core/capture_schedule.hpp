@@ -0,0 +1,140 @@
+#pragma once
+// Which card to capture next. Callers describe card i through `stateOf(i)`,
+// which returns an SCardCaptureState.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+struct SCardCaptureState {
+  bool captured = false;
+  bool onScreen = false;
+  std::chrono::steady_clock::time_point lastCaptureAt{};
+};
+
+inline bool inCaptureRadius(int idx, int currentIdx, int radius) {
+  if (idx == currentIdx)
+    return true;
+  if (radius <= 0)
+    return false;
+  return std::abs(idx - currentIdx) <= radius;
+}
+
+// Nearest on-screen card without a capture within `radius` of the centre.
+// Equal distances prefer the lower index.
+template <typename StateOf>
+int pickNearestUncapturedCard(int count, int currentIdx, int radius,
+                              StateOf&& stateOf) {
+  if (currentIdx < 0 || currentIdx >= count)
+    return -1;
+
+  const auto wanted = [&](int i) {
+    const SCardCaptureState st = stateOf(i);
+    return !st.captured && st.onScreen;
+  };
+  if (wanted(currentIdx))
+    return currentIdx;
+
+  const int reach = std::min(std::max(0, radius), count);
+  for (int d = 1; d <= reach; ++d) {
+    if (currentIdx - d >= 0 && wanted(currentIdx - d))
+      return currentIdx - d;
+    if (currentIdx + d < count && wanted(currentIdx + d))
+      return currentIdx + d;
+  }
+  return -1;
+}
+
+// Least recently captured visible neighbour whose preview is older than one
+// live-preview interval, or -1.
+template <typename StateOf>
+int pickLivePreviewCard(int count, int currentIdx, int radius, float fps,
+                        std::chrono::steady_clock::time_point now, StateOf&& stateOf) {
+  if (count < 2 || radius <= 0)
+    return -1;
+
+  fps = std::clamp(fps, 0.0f, 60.0f);
+  if (fps <= 0.0f)
+    return -1;
+  const auto minInterval = std::chrono::duration<float>(1.0f / fps);
+
+  int bestIdx = -1;
+  auto bestCaptureTime = std::chrono::steady_clock::time_point::max();
+  const int first = std::max(0, currentIdx - radius);
+  const int last = std::min(count - 1, currentIdx + radius);
+  for (int i = first; i <= last; ++i) {
+    if (i == currentIdx)
+      continue;
+    const SCardCaptureState st = stateOf(i);
+    if (!st.captured || !st.onScreen)
+      continue;
+    if (now - st.lastCaptureAt < minInterval)
+      continue;
+    if (bestIdx == -1 || st.lastCaptureAt < bestCaptureTime) {
+      bestIdx = i;
+      bestCaptureTime = st.lastCaptureAt;
+    }
+  }
+  return bestIdx;
+}
+
+// One open overview, as seen by the capture scheduler shared across outputs.
+struct SOutputCaptureDemand {
+  float refreshHz = 60.0f;
+  bool focused = false;
+  bool missingCards = false;
+};
+
+// Per-frame capture budget for outputs[idx] when several overviews share the
+// GPU. `budgetMs` is what a single output would get per frame. Time is split
+// per second by weight (focused x2, outputs still missing cards x2) and then
+// converted back to a per-frame slice, so a 60 Hz output gets a slice twice
+// as large as a 120 Hz one with the same weight.
+inline float captureBudgetForOutput(float budgetMs,
+                                    const std::vector<SOutputCaptureDemand>& outputs,
+                                    size_t idx) {
+  if (budgetMs <= 0.0f || idx >= outputs.size())
+    return budgetMs;
+  if (outputs.size() == 1)
+    return budgetMs;
+
+  const auto weightOf = [](const SOutputCaptureDemand& out) {
+    return (out.focused ? 2.0f : 1.0f) * (out.missingCards ? 2.0f : 1.0f);
+  };
+  const auto hzOf = [](const SOutputCaptureDemand& out) {
+    return std::clamp(out.refreshHz, 1.0f, 1000.0f);
+  };
+
+  float maxHz = 0.0f;
+  float totalWeight = 0.0f;
+  for (const auto& out : outputs) {
+    maxHz = std::max(maxHz, hzOf(out));
+    totalWeight += weightOf(out);
+  }
+
+  const float perSecondMs = budgetMs * maxHz * weightOf(outputs[idx]) / totalWeight;
+  return perSecondMs / hzOf(outputs[idx]);
+}
+
+// Workspaces to keep warm while the overview is closed: activeID+1 and -1
+// (where horza:workspace +1/-1 lands), then `recentIDs`, most recent first.
+// Skips the active workspace, duplicates and IDs `available` rejects.
+template <typename Available>
+void pickPrefetchWorkspaces(int64_t activeID, const std::vector<int64_t>& recentIDs,
+                            size_t limit, Available&& available,
+                            std::vector<int64_t>& out) {
+  out.clear();
+  const auto consider = [&](int64_t id) {
+    if (out.size() >= limit || id <= 0 || id == activeID)
+      return;
+    if (std::find(out.begin(), out.end(), id) != out.end() || !available(id))
+      return;
+    out.push_back(id);
+  };
+
+  consider(activeID + 1);
+  consider(activeID - 1);
+  for (const int64_t id : recentIDs)
+    consider(id);
+}
@@ -0,0 +1,34 @@
+#pragma once
+// The slice of compositor state the core logic reads. The plugin implements it
+// on top of Hyprland's globals; benchmarks use a plain in-memory stub.
+#include <cstdint>
+#include <vector>
+
+struct SWorkspaceInfo {
+  int64_t id = -1;
+  int monitorID = -1;
+};
+
+class ICompositorView {
+public:
+  virtual ~ICompositorView() = default;
+
+  virtual void listWorkspaces(std::vector<SWorkspaceInfo>& out) const = 0;
+  virtual int64_t activeWorkspaceID(int monitorID) const = 0;
+};
+
+// In-memory view for benchmarks and tools that run without a compositor.
+class CStubCompositorView : public ICompositorView {
+public:
+  std::vector<SWorkspaceInfo> workspaces;
+  std::vector<int64_t> activeByMonitor;
+
+  void listWorkspaces(std::vector<SWorkspaceInfo>& out) const override {
+    out.insert(out.end(), workspaces.begin(), workspaces.end());
+  }
+  int64_t activeWorkspaceID(int monitorID) const override {
+    if (monitorID < 0 || monitorID >= (int)activeByMonitor.size())
+      return -1;
+    return activeByMonitor[monitorID];
+  }
+};
@@ -0,0 +1,39 @@
+#include "config_parse.hpp"
+
+bool parseStrictBool(const std::string& raw, bool& out) {
+  const auto token = normalizeHorzaToken(horzaTrim(raw));
+  if (token == "true") {
+    out = true;
+    return true;
+  }
+  if (token == "false") {
+    out = false;
+    return true;
+  }
+  return false;
+}
+
+bool parseCaptureFormat(const std::string& raw, std::string& out) {
+  const auto format = normalizeHorzaToken(horzaTrim(raw));
+  if (format == "auto" || format == "native")
+    out = "auto";
+  else if (format == "8bit" || format == "8" || format == "argb8888")
+    out = "8bit";
+  else if (format == "compact" || format == "rgb565" || format == "565" ||
+           format == "16bit")
+    out = "compact";
+  else
+    return false;
+  return true;
+}
+
+bool parseCardShadowMode(const std::string& raw, std::string& out) {
+  const auto mode = normalizeHorzaToken(horzaTrim(raw));
+  if (mode == "fast" || mode == "box" || mode == "rect")
+    out = "fast";
+  else if (mode == "texture" || mode == "png" || mode == "image")
+    out = "texture";
+  else
+    return false;
+  return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+// Value clamping and token parsing for plugin options.
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string>
+
+inline float clampCaptureScale(float v) {
+  if (!std::isfinite(v) || v <= 0.0f)
+    return 1.0f;
+  return std::clamp(v, 0.05f, 1.0f);
+}
+
+inline float clampDisplayScale(float v) {
+  if (!std::isfinite(v))
+    return 0.60f;
+  return std::clamp(v, 0.05f, 3.0f);
+}
+
+inline float effectiveDisplayScale(float configured) {
+  const float clamped = clampDisplayScale(configured);
+  // A configured 1.0 has no geometric headroom for enter/exit animation.
+  // Keep it visually near-1 while preserving a smooth close/open path.
+  if (std::fabs(clamped - 1.0f) < 0.001f)
+    return 0.985f;
+  return clamped;
+}
+
+inline float clampInactiveTileSizePercent(float v) {
+  if (!std::isfinite(v))
+    return 85.0f;
+  return std::clamp(v, 0.0f, 100.0f);
+}
+
+inline float clampFramePumpFps(float v) {
+  if (!std::isfinite(v) || v <= 0.0f)
+    return 0.0f;
+  return std::clamp(v, 1.0f, 240.0f);
+}
+
+inline std::string horzaTrim(const std::string& s) {
+  const size_t start = s.find_first_not_of(" \t\r\n");
+  const size_t end = s.find_last_not_of(" \t\r\n");
+  return (start == std::string::npos) ? "" : s.substr(start, end - start + 1);
+}
+
+inline std::string normalizeHorzaToken(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  std::replace(s.begin(), s.end(), '-', '_');
+  return s;
+}
+
+inline std::string stripWrappedQuotes(const std::string& s) {
+  if (s.size() >= 2 &&
+      ((s.front() == '"' && s.back() == '"') ||
+       (s.front() == '\'' && s.back() == '\'')))
+    return s.substr(1, s.size() - 2);
+  return s;
+}
+
+// Accepts exactly "true"/"false" (case-insensitive, surrounding whitespace ok).
+bool parseStrictBool(const std::string& raw, bool& out);
+
+// Canonicalize option aliases; return false (leaving out alone) for unknown values.
+bool parseCaptureFormat(const std::string& raw, std::string& out);
+bool parseCardShadowMode(const std::string& raw, std::string& out);
@@ -0,0 +1,53 @@
+#include "layout.hpp"
+
+SStripLayout computeStripLayout(const SStripLayoutParams& p) {
+  SStripLayout l;
+  const float ds = std::max(p.displayScale, 0.0001f);
+  l.tileW = p.monitorW * p.scale;
+  l.tileH = p.monitorH * p.scale;
+  l.gap = p.gap * (p.scale / ds);
+  l.vertical = p.vertical;
+  l.inactiveScale = std::clamp(p.inactiveScale, 0.0f, 1.0f);
+
+  if (!p.vertical) {
+    const float centerX =
+        p.monitorW * 0.5f - (p.currentIdx * (l.tileW + l.gap) + l.tileW * 0.5f);
+    l.startX = centerX + p.primaryOffset;
+    l.startY = (p.monitorH - l.tileH) * 0.5f + p.crossOffset;
+  } else {
+    const float centerY =
+        p.monitorH * 0.5f - (p.currentIdx * (l.tileH + l.gap) + l.tileH * 0.5f);
+    l.startY = centerY + p.primaryOffset;
+    l.startX = (p.monitorW - l.tileW) * 0.5f + p.crossOffset;
+  }
+
+  l.centerPrimary = !p.vertical ? p.monitorW * 0.5f : p.monitorH * 0.5f;
+  l.step = !p.vertical ? (l.tileW + l.gap) : (l.tileH + l.gap);
+  l.startPrimary = !p.vertical ? l.startX : l.startY;
+  return l;
+}
+
+SCardRect stripCardRect(const SStripLayout& l, int idx, float* outSizeFactor) {
+  const float baseX = !l.vertical ? l.startX + idx * l.step : l.startX;
+  const float baseY = !l.vertical ? l.startY : l.startY + idx * l.step;
+  const float tileCenterPrimary =
+      !l.vertical ? baseX + l.tileW * 0.5f : baseY + l.tileH * 0.5f;
+  const float normFromCenter =
+      l.step > 0.001f
+          ? std::clamp(std::abs(tileCenterPrimary - l.centerPrimary) / l.step, 0.0f,
+                       1.0f)
+          : 1.0f;
+  const float sizeFactor = 1.0f - (1.0f - l.inactiveScale) * normFromCenter;
+  const float drawW = l.tileW * sizeFactor;
+  const float drawH = l.tileH * sizeFactor;
+  if (outSizeFactor)
+    *outSizeFactor = sizeFactor;
+  return {baseX - (drawW - l.tileW) * 0.5f, baseY - (drawH - l.tileH) * 0.5f, drawW,
+          drawH};
+}
+
+bool cardRectOnScreen(const SCardRect& r, double monitorW, double monitorH) {
+  if (r.w <= 1.0 || r.h <= 1.0)
+    return false;
+  return r.x + r.w > 0.0 && r.y + r.h > 0.0 && r.x < monitorW && r.y < monitorH;
+}
@@ -0,0 +1,70 @@
+#pragma once
+// Card strip geometry. Everything is in monitor-local logical coordinates.
+#include <algorithm>
+#include <cmath>
+
+struct SCardRect {
+  double x = 0.0;
+  double y = 0.0;
+  double w = 0.0;
+  double h = 0.0;
+};
+
+struct SStripLayoutParams {
+  double monitorW = 0.0;
+  double monitorH = 0.0;
+  // Current (animated) card scale and the configured target it animates to;
+  // the gap grows with scale / displayScale so spacing keeps its proportion.
+  float scale = 1.0f;
+  float displayScale = 1.0f;
+  float gap = 0.0f;
+  bool vertical = false;
+  float crossOffset = 0.0f;
+  float primaryOffset = 0.0f;
+  // Size factor of cards one step or more away from the centre.
+  float inactiveScale = 1.0f;
+  int currentIdx = 0;
+};
+
+struct SStripLayout {
+  float tileW = 0.0f;
+  float tileH = 0.0f;
+  float gap = 0.0f;
+  float step = 0.0f;
+  float startX = 0.0f;
+  float startY = 0.0f;
+  float startPrimary = 0.0f;
+  float centerPrimary = 0.0f;
+  float inactiveScale = 1.0f;
+  bool vertical = false;
+};
+
+SStripLayout computeStripLayout(const SStripLayoutParams& params);
+
+// Box of card `idx`, shrunk towards inactiveScale with distance from the
+// centre. outSizeFactor receives that factor (1 at the centre).
+SCardRect stripCardRect(const SStripLayout& layout, int idx,
+                        float* outSizeFactor = nullptr);
+
+bool cardRectOnScreen(const SCardRect& rect, double monitorW, double monitorH);
+
+// Cards sit on a uniform grid along the primary axis, so only the slot under
+// the point (and its neighbours, in case of overlap) can contain it. `rectOf`
+// returns the drawn box of card i; anything with x/y/w/h members works.
+template <typename RectOf>
+int hitStripCard(const SStripLayout& layout, int count, double px, double py,
+                 RectOf&& rectOf) {
+  if (count <= 0 || layout.step <= 0.0f)
+    return -1;
+
+  const double primary = layout.vertical ? py : px;
+  const int slot = (int)std::floor((primary - layout.startPrimary) / layout.step);
+  const int first = std::max(0, slot - 1);
+  const int last = std::min(count - 1, slot + 1);
+  for (int i = first; i <= last; ++i) {
+    const auto& b = rectOf(i);
+    if (px >= b.x && px <= b.x + b.w && py >= b.y && py <= b.y + b.h)
+      return i;
+  }
+  return -1;
+}
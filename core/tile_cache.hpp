@@ -0,0 +1,115 @@
+#pragma once
+// Persistent workspace tile cache policy (TTL + LRU cap), independent of what
+// is stored. The plugin stores framebuffers; benchmarks store plain integers.
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+struct STileCacheKey {
+  int monitorID = -1;
+  int64_t workspaceID = -1;
+
+  bool operator==(const STileCacheKey& other) const = default;
+};
+
+struct STileCacheKeyHash {
+  size_t operator()(const STileCacheKey& key) const noexcept {
+    const size_t h1 = std::hash<int>{}(key.monitorID);
+    const size_t h2 = std::hash<int64_t>{}(key.workspaceID);
+    return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6U) + (h1 >> 2U));
+  }
+};
+
+template <typename Payload>
+class CTileCache {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct SEntry {
+    Payload payload{};
+    Clock::time_point capturedAt{};
+    Clock::time_point cachedAt{};
+  };
+
+  // Drops entries that are dead or older than ttl, then the least recently
+  // used ones until at most maxEntries remain. Returns how many were dropped.
+  template <typename IsAlive>
+  size_t prune(Clock::time_point now, Clock::duration ttl, size_t maxEntries,
+               IsAlive&& isAlive) {
+    const size_t before = entries.size();
+    std::erase_if(entries, [&](const auto& kv) {
+      return !isAlive(kv.second.payload) || now - kv.second.cachedAt > ttl;
+    });
+
+    if (entries.size() > maxEntries) {
+      std::vector<Clock::time_point> ages;
+      ages.reserve(entries.size());
+      for (const auto& [key, entry] : entries)
+        ages.push_back(entry.cachedAt);
+      const size_t excess = entries.size() - maxEntries;
+      std::nth_element(ages.begin(), ages.begin() + (excess - 1), ages.end());
+      const auto cutoff = ages[excess - 1];
+
+      // Entries strictly older than the cutoff always go; ties at the cutoff
+      // go only while still over the cap.
+      size_t toDrop = excess;
+      std::erase_if(entries, [&](const auto& kv) {
+        if (toDrop > 0 && kv.second.cachedAt < cutoff) {
+          toDrop--;
+          return true;
+        }
+        return false;
+      });
+      std::erase_if(entries, [&](const auto& kv) {
+        if (toDrop > 0 && kv.second.cachedAt == cutoff) {
+          toDrop--;
+          return true;
+        }
+        return false;
+      });
+    }
+
+    return before - entries.size();
+  }
+
+  void store(const STileCacheKey& key, Payload payload, Clock::time_point capturedAt,
+             Clock::time_point now) {
+    entries[key] = {
+        .payload = std::move(payload),
+        .capturedAt = capturedAt.time_since_epoch().count() == 0 ? now : capturedAt,
+        .cachedAt = now,
+    };
+  }
+
+  // Returns the entry and marks it recently used, or nullptr.
+  SEntry* touch(const STileCacheKey& key, Clock::time_point now) {
+    const auto it = entries.find(key);
+    if (it == entries.end())
+      return nullptr;
+    it->second.cachedAt = now;
+    return &it->second;
+  }
+
+  // Returns the entry without changing its recency, or nullptr.
+  const SEntry* find(const STileCacheKey& key) const {
+    const auto it = entries.find(key);
+    return it == entries.end() ? nullptr : &it->second;
+  }
+
+  bool erase(const STileCacheKey& key) { return entries.erase(key) > 0; }
+  void clear() { entries.clear(); }
+  size_t size() const { return entries.size(); }
+
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const auto& [key, entry] : entries)
+      fn(key, entry);
+  }
+
+private:
+  std::unordered_map<STileCacheKey, SEntry, STileCacheKeyHash> entries;
+};
@@ -0,0 +1,56 @@
+#include "workspace_reconcile.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+void collectMonitorWorkspaceIDs(const ICompositorView& view, int monitorID,
+                                std::vector<int64_t>& out) {
+  static thread_local std::vector<SWorkspaceInfo> all;
+  all.clear();
+  view.listWorkspaces(all);
+
+  out.clear();
+  for (const auto& ws : all) {
+    if (ws.monitorID != monitorID || ws.id < 0)
+      continue;
+    out.push_back(ws.id);
+  }
+  std::sort(out.begin(), out.end());
+}
+
+SWorkspaceReconcile reconcileWorkspaceList(const std::vector<int64_t>& oldIDs,
+                                           const std::vector<int64_t>& newIDs,
+                                           int64_t previousCenterID,
+                                           int64_t activeID, int currentIdx) {
+  SWorkspaceReconcile out;
+  out.oldIndexFor.assign(newIDs.size(), -1);
+
+  std::unordered_map<int64_t, int> oldIndexByID;
+  oldIndexByID.reserve(oldIDs.size());
+  for (int i = 0; i < (int)oldIDs.size(); ++i) {
+    if (oldIDs[i] >= 0)
+      oldIndexByID.try_emplace(oldIDs[i], i);
+  }
+  for (size_t n = 0; n < newIDs.size(); ++n) {
+    const auto it = oldIndexByID.find(newIDs[n]);
+    if (it != oldIndexByID.end())
+      out.oldIndexFor[n] = it->second;
+  }
+
+  if (newIDs.empty())
+    return out;
+
+  // newIDs is sorted.
+  const auto indexOf = [&](int64_t id) {
+    if (id < 0)
+      return -1;
+    const auto it = std::lower_bound(newIDs.begin(), newIDs.end(), id);
+    return it == newIDs.end() || *it != id ? -1 : (int)(it - newIDs.begin());
+  };
+
+  out.currentIdx = indexOf(previousCenterID);
+  if (out.currentIdx == -1)
+    out.currentIdx = indexOf(activeID);
+  if (out.currentIdx == -1)
+    out.currentIdx = std::clamp(currentIdx, 0, (int)newIDs.size() - 1);
+  return out;
+}
@@ -0,0 +1,24 @@
+#pragma once
+// Workspace list reconciliation: maps a fresh, sorted list of workspace IDs
+// onto the cards the overview already has.
+#include "compositor_view.hpp"
+#include <cstdint>
+#include <vector>
+
+// Sorted IDs of the regular (non-special) workspaces on a monitor.
+void collectMonitorWorkspaceIDs(const ICompositorView& view, int monitorID,
+                                std::vector<int64_t>& out);
+
+struct SWorkspaceReconcile {
+  // For each new card, the index of the old card it continues, or -1.
+  std::vector<int> oldIndexFor;
+  int currentIdx = -1;
+};
+
+// newIDs must be sorted; oldIDs may contain -1 for cards whose workspace is
+// gone. The centre stays on previousCenterID if it survived, else moves to
+// activeID, else keeps its index clamped to the new list.
+SWorkspaceReconcile reconcileWorkspaceList(const std::vector<int64_t>& oldIDs,
+                                           const std::vector<int64_t>& newIDs,
+                                           int64_t previousCenterID,
+                                           int64_t activeID, int currentIdx);
@@ -63,19 +63,6 @@ bool getPluginString(const std::string& key, std::string& out) {
 
 const char* boolToToken(bool v) { return v ? "true" : "false"; }
 
-bool parseStrictBool(const std::string& raw, bool& out) {
-  const auto token = normalizeHorzaToken(horzaTrim(raw));
-  if (token == "true") {
-    out = true;
-    return true;
-  }
-  if (token == "false") {
-    out = false;
-    return true;
-  }
-  return false;
-}
-
 bool getPluginBool(const std::string& key, bool& out) {
   std::string raw;
   if (!getPluginString(key, raw))
@@ -95,6 +82,7 @@ bool getPluginBool(const std::string& key, bool& out) {
 void registerPluginConfigValues() {
   const char* defaultBackground =
       g_horzaConfig.hyprpaperBackground ? "hyprpaper" : "black";
+  const char* defaultCaptureFormat = g_horzaConfig.captureFormat.c_str();
   const char* defaultShadowMode =
       normalizeHorzaToken(g_horzaConfig.cardShadowMode) == "texture" ? "texture"
                                                                       : "fast";
@@ -110,6 +98,13 @@ void registerPluginConfigValues() {
   addPluginConfigValue(
       "capture_scale",
       Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.captureScale});
+  addPluginConfigValue("capture_format",
+                       Hyprlang::CConfigValue{defaultCaptureFormat});
+  addPluginConfigValue(
+      "reuse_presented_frame",
+      Hyprlang::CConfigValue{boolToToken(g_horzaConfig.reusePresentedFrame)});
+  addPluginConfigValue("downsample_cards",
+                       Hyprlang::CConfigValue{boolToToken(g_horzaConfig.downsampleCards)});
   addPluginConfigValue(
       "display_scale",
       Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.displayScale});
@@ -122,6 +117,17 @@ void registerPluginConfigValues() {
           (Hyprlang::FLOAT)g_horzaConfig.inactiveTileSizePercent});
   addPluginConfigValue("persistent_cache", Hyprlang::CConfigValue{
                                                boolToToken(g_horzaConfig.persistentCache)});
+  addPluginConfigValue("capture_on_leave", Hyprlang::CConfigValue{
+                                               boolToToken(g_horzaConfig.captureOnLeave)});
+  addPluginConfigValue(
+      "capture_on_leave_interval_ms",
+      Hyprlang::CConfigValue{
+          (Hyprlang::FLOAT)g_horzaConfig.captureOnLeaveIntervalMs});
+  addPluginConfigValue("idle_prefetch", Hyprlang::CConfigValue{
+                                            boolToToken(g_horzaConfig.idlePrefetch)});
+  addPluginConfigValue(
+      "idle_prefetch_interval_ms",
+      Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.idlePrefetchIntervalMs});
   addPluginConfigValue(
       "cache_ttl_ms",
       Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.cacheTtlMs});
@@ -139,8 +145,25 @@ void registerPluginConfigValues() {
   addPluginConfigValue(
       "live_preview_radius",
       Hyprlang::CConfigValue{(Hyprlang::INT)g_horzaConfig.livePreviewRadius});
+  addPluginConfigValue(
+      "adaptive_live_preview",
+      Hyprlang::CConfigValue{boolToToken(g_horzaConfig.adaptiveLivePreview)});
+  addPluginConfigValue(
+      "live_preview_fps_min",
+      Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.livePreviewFpsMin});
+  addPluginConfigValue(
+      "adaptive_max_captures_per_frame",
+      Hyprlang::CConfigValue{
+          (Hyprlang::INT)g_horzaConfig.adaptiveMaxCapturesPerFrame});
   addPluginConfigValue("prewarm_all",
                        Hyprlang::CConfigValue{boolToToken(g_horzaConfig.prewarmAll)});
+  addPluginConfigValue(
+      "transit_cache_max_age_ms",
+      Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.transitCacheMaxAgeMs});
+  addPluginConfigValue(
+      "open_first_frame_deadline_ms",
+      Hyprlang::CConfigValue{
+          (Hyprlang::FLOAT)g_horzaConfig.openFirstFrameDeadlineMs});
   addPluginConfigValue("frame_pump",
                        Hyprlang::CConfigValue{boolToToken(g_horzaConfig.framePump)});
   addPluginConfigValue(
@@ -196,6 +219,13 @@ void registerPluginConfigValues() {
           boolToToken(g_horzaConfig.freezeAnimationsInOverview)});
   addPluginConfigValue("esc_only",
                        Hyprlang::CConfigValue{boolToToken(g_horzaConfig.escOnly)});
+  addPluginConfigValue(
+      "keyboard_navigation",
+      Hyprlang::CConfigValue{boolToToken(g_horzaConfig.keyboardNavigation)});
+  addPluginConfigValue("all_monitors",
+                       Hyprlang::CConfigValue{boolToToken(g_horzaConfig.allMonitors)});
+  addPluginConfigValue("touchpad_follow",
+                       Hyprlang::CConfigValue{boolToToken(g_horzaConfig.touchpadFollow)});
   addPluginConfigValue(
       "drag_hover_jump_delay_ms",
       Hyprlang::CConfigValue{(Hyprlang::FLOAT)g_horzaConfig.dragHoverJumpDelayMs});
@@ -216,6 +246,12 @@ void applyPluginConfigOverrides() {
 
   if (getPluginFloat("capture_scale", f))
     g_horzaConfig.captureScale = clampCaptureScale((float)f);
+  if (getPluginString("capture_format", s))
+    parseCaptureFormat(s, g_horzaConfig.captureFormat);
+  if (getPluginBool("reuse_presented_frame", b))
+    g_horzaConfig.reusePresentedFrame = b;
+  if (getPluginBool("downsample_cards", b))
+    g_horzaConfig.downsampleCards = b;
   if (getPluginFloat("display_scale", f))
     g_horzaConfig.displayScale = clampDisplayScale((float)f);
   if (getPluginFloat("overview_gap", f))
@@ -225,6 +261,14 @@ void applyPluginConfigOverrides() {
         clampInactiveTileSizePercent((float)f);
   if (getPluginBool("persistent_cache", b))
     g_horzaConfig.persistentCache = b;
+  if (getPluginBool("capture_on_leave", b))
+    g_horzaConfig.captureOnLeave = b;
+  if (getPluginFloat("capture_on_leave_interval_ms", f))
+    g_horzaConfig.captureOnLeaveIntervalMs = std::max(0.0f, (float)f);
+  if (getPluginBool("idle_prefetch", b))
+    g_horzaConfig.idlePrefetch = b;
+  if (getPluginFloat("idle_prefetch_interval_ms", f))
+    g_horzaConfig.idlePrefetchIntervalMs = std::max(100.0f, (float)f);
   if (getPluginFloat("cache_ttl_ms", f))
     g_horzaConfig.cacheTtlMs = std::max(0.0f, (float)f);
   if (getPluginInt("cache_max_entries", i))
@@ -237,8 +281,18 @@ void applyPluginConfigOverrides() {
     g_horzaConfig.livePreviewFps = std::max(0.0f, (float)f);
   if (getPluginInt("live_preview_radius", i))
     g_horzaConfig.livePreviewRadius = std::max(0, (int)i);
+  if (getPluginBool("adaptive_live_preview", b))
+    g_horzaConfig.adaptiveLivePreview = b;
+  if (getPluginFloat("live_preview_fps_min", f))
+    g_horzaConfig.livePreviewFpsMin = std::max(0.0f, (float)f);
+  if (getPluginInt("adaptive_max_captures_per_frame", i))
+    g_horzaConfig.adaptiveMaxCapturesPerFrame = std::max(0, (int)i);
   if (getPluginBool("prewarm_all", b))
     g_horzaConfig.prewarmAll = b;
+  if (getPluginFloat("transit_cache_max_age_ms", f))
+    g_horzaConfig.transitCacheMaxAgeMs = std::max(0.0f, (float)f);
+  if (getPluginFloat("open_first_frame_deadline_ms", f))
+    g_horzaConfig.openFirstFrameDeadlineMs = std::max(0.0f, (float)f);
   if (getPluginBool("frame_pump", b))
     g_horzaConfig.framePump = b;
   if (getPluginBool("frame_pump_aggressive", b))
@@ -264,13 +318,8 @@ void applyPluginConfigOverrides() {
     g_horzaConfig.backgroundTint = std::clamp((float)f, 0.0f, 1.0f);
   if (getPluginBool("card_shadow", b))
     g_horzaConfig.cardShadow = b;
-  if (getPluginString("card_shadow_mode", s)) {
-    const auto mode = normalizeHorzaToken(horzaTrim(s));
-    if (mode == "fast" || mode == "box" || mode == "rect")
-      g_horzaConfig.cardShadowMode = "fast";
-    else if (mode == "texture" || mode == "png" || mode == "image")
-      g_horzaConfig.cardShadowMode = "texture";
-  }
+  if (getPluginString("card_shadow_mode", s))
+    parseCardShadowMode(s, g_horzaConfig.cardShadowMode);
   if (getPluginString("card_shadow_texture", s))
     g_horzaConfig.cardShadowTexture = horzaTrim(s);
   if (getPluginFloat("card_shadow_alpha", f))
@@ -291,6 +340,12 @@ void applyPluginConfigOverrides() {
     g_horzaConfig.freezeAnimationsInOverview = b;
   if (getPluginBool("esc_only", b))
     g_horzaConfig.escOnly = b;
+  if (getPluginBool("keyboard_navigation", b))
+    g_horzaConfig.keyboardNavigation = b;
+  if (getPluginBool("all_monitors", b))
+    g_horzaConfig.allMonitors = b;
+  if (getPluginBool("touchpad_follow", b))
+    g_horzaConfig.touchpadFollow = b;
   if (getPluginFloat("drag_hover_jump_delay_ms", f))
     g_horzaConfig.dragHoverJumpDelayMs = std::max(0.0f, (float)f);
   if (getPluginBool("vertical", b))
@@ -338,5 +393,5 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
 APICALL EXPORT void PLUGIN_EXIT() {
   g_pPluginRuntime.reset();
-  g_pOverview.reset();
+  g_overviews.clear();
 }
@@ -1,10 +1,10 @@
 // Overview lifecycle and frame orchestration (constructor, pre-render, state transitions).
 #include "overview.hpp"
 #include "OverviewPassElement.hpp"
+#include "plugin_runtime.hpp"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <limits>
 #include <string>
 
 #define private public
@@ -12,15 +12,41 @@
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/debug/log/Logger.hpp>
 #include <hyprland/src/desktop/state/FocusState.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/managers/animation/AnimationManager.hpp>
 #include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 #include <hyprland/src/render/Renderer.hpp>
 #undef private
 
-static void
-damageCallback(WP<Hyprutils::Animation::CBaseAnimatedVariable> var) {
-  if (g_pOverview)
-    g_pOverview->damage();
+COverview* overviewForMonitor(const CMonitor* mon) {
+  if (!mon)
+    return nullptr;
+  for (const auto& ov : g_overviews) {
+    const auto ovMon = ov->pMonitor.lock();
+    if (ovMon && ovMon->m_id == mon->m_id)
+      return ov.get();
+  }
+  return nullptr;
+}
+
+COverview* focusedOverview() {
+  if (g_overviews.empty())
+    return nullptr;
+  if (auto* ov = overviewForMonitor(Desktop::focusState()->monitor().get()))
+    return ov;
+  return g_overviews.front().get();
+}
+
+bool overviewAlive(const COverview* ov) {
+  return ov && std::ranges::any_of(g_overviews, [ov](const auto& other) {
+           return other.get() == ov;
+         });
+}
+
+void destroyOverview(const COverview* ov) {
+  std::erase_if(g_overviews, [ov](const auto& other) { return other.get() == ov; });
+  if (g_overviews.empty() && g_pPluginRuntime)
+    g_pPluginRuntime->releaseOverviewHooksLater();
 }
 
 static SP<Hyprutils::Animation::SAnimationPropertyConfig> makeAnimConfig() {
@@ -50,7 +76,7 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
                      PHLWORKSPACE transitDest_)
     : transitMode(transitMode_) {
 
-  const auto PMONITOR = Desktop::focusState()->monitor();
+  const auto PMONITOR = startedOn_ ? startedOn_->m_monitor.lock() : nullptr;
   if (!PMONITOR || !startedOn_) {
     std::cerr << "[horza] cannot open overview: missing focused monitor/workspace\n";
     return;
@@ -66,7 +92,8 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
   std::vector<PHLWORKSPACE> wsList;
   for (auto &wsWeak : g_pCompositor->m_workspaces) {
     auto ws = wsWeak.lock();
-    if (!ws)
+    // Same rule as the workspace sync's tracksWorkspace.
+    if (!ws || ws->m_inert)
       continue;
     if (ws->monitorID() == PMONITOR->m_id && ws->m_id >= 0)
       wsList.push_back(ws);
@@ -92,15 +119,18 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
 
   g_pAnimationManager->createAnimation(1.0f, m_scale, makeAnimConfig(),
                                        AVARDAMAGE_NONE);
-  m_scale->setUpdateCallback(damageCallback);
+  m_scale->setUpdateCallback(
+      [this](WP<Hyprutils::Animation::CBaseAnimatedVariable>) { damage(); });
 
   g_pAnimationManager->createAnimation(0.0f, m_offsetX, makeAnimConfig(),
                                        AVARDAMAGE_NONE);
-  m_offsetX->setUpdateCallback(damageCallback);
+  m_offsetX->setUpdateCallback(
+      [this](WP<Hyprutils::Animation::CBaseAnimatedVariable>) { damage(); });
 
   g_pAnimationManager->createAnimation(0.0f, m_crossOffset, makeAnimConfig(),
                                        AVARDAMAGE_NONE);
-  m_crossOffset->setUpdateCallback(damageCallback);
+  m_crossOffset->setUpdateCallback(
+      [this](WP<Hyprutils::Animation::CBaseAnimatedVariable>) { damage(); });
   m_crossOffset->setValueAndWarp(0.0f);
 
   if (transitMode) {
@@ -112,14 +142,32 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
     m_crossOffset->setValueAndWarp(0.0f);
     openAnimPending = false;
 
+    // A slide only lasts a few frames; a recent cached tile is good enough
+    // and saves a full workspace render per keypress.
+    // Freshness is checked first so a stale tile is never restored (and
+    // mip-mapped) only to be replaced by a capture.
+    const auto useFreshCachedTile = [&](int idx) {
+      const auto& ws = images[idx].pWorkspace;
+      if (!ws || !cachedWorkspaceTileFresh(PMONITOR->m_id, ws->m_id,
+                                           g_horzaConfig.transitCacheMaxAgeMs))
+        return false;
+      if (!restoreTileFromCache(idx))
+        return false;
+      g_horzaStats.transitCacheHits++;
+      return true;
+    };
+
     blockOverviewRendering = true;
-    images[currentIdx].captured = captureWorkspace(currentIdx);
+    if (captureFromPresentedFrame(currentIdx))
+      images[currentIdx].captured = true;
+    else if (!useFreshCachedTile(currentIdx))
+      images[currentIdx].captured = captureWorkspace(currentIdx);
 
     if (transitDest_ && transitDest_ != startedOn_) {
       for (int i = 0; i < (int)images.size(); ++i) {
         if (images[i].pWorkspace != transitDest_)
           continue;
-        if (!images[i].captured)
+        if (!images[i].captured && !useFreshCachedTile(i))
           images[i].captured = captureWorkspace(i);
         break;
       }
@@ -145,9 +193,17 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
   for (int i = 0; i < (int)images.size(); ++i)
     restoreTileFromCache(i);
 
+  const auto openStartedAt = std::chrono::steady_clock::now();
+  const float firstFrameDeadlineMs =
+      std::max(0.0f, g_horzaConfig.openFirstFrameDeadlineMs);
+  progressiveOpen = firstFrameDeadlineMs > 0.0f;
+
   backgroundCaptured = false;
   blockOverviewRendering = true;
-  if (!images[currentIdx].cachedTex) {
+  if (captureFromPresentedFrame(currentIdx)) {
+    // The card starts from exactly what was on screen; no render needed.
+    images[currentIdx].captured = true;
+  } else if (!images[currentIdx].cachedTex) {
     images[currentIdx].captured = captureWorkspace(currentIdx);
     if (!images[currentIdx].captured) {
       damageDirty = true;
@@ -159,9 +215,37 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
   } else if (!images[currentIdx].captured) {
     damageDirty = true;
   }
-  if (g_horzaConfig.hyprpaperBackground)
-    captureBackground();
-  if (g_horzaConfig.prewarmAll) {
+  if (g_horzaConfig.hyprpaperBackground) {
+    if (progressiveOpen) {
+      // The previous open's background is close enough for the first frames.
+      restoreRetainedBackground();
+      backgroundRefreshPending = true;
+    } else {
+      captureBackground();
+    }
+  }
+  if (progressiveOpen) {
+    // Nearest cards first: capture while the deadline allows, queue the rest.
+    const int prewarmRadius =
+        g_horzaConfig.prewarmAll
+            ? (int)images.size()
+            : std::clamp(g_horzaConfig.livePreviewRadius, 0, 4);
+    for (int d = 1; d <= prewarmRadius; ++d) {
+      for (const int idx : {currentIdx - d, currentIdx + d}) {
+        if (idx < 0 || idx >= (int)images.size() || images[idx].captured)
+          continue;
+        const float elapsedMs = std::chrono::duration<float, std::milli>(
+                                    std::chrono::steady_clock::now() - openStartedAt)
+                                    .count();
+        if (elapsedMs >= firstFrameDeadlineMs) {
+          queueWorkspaceCapture(idx);
+          continue;
+        }
+        images[idx].captured = captureWorkspace(idx);
+        images[idx].cachedTex.reset();
+      }
+    }
+  } else if (g_horzaConfig.prewarmAll) {
     for (int i = 0; i < (int)images.size(); ++i) {
       if (images[i].captured)
         continue;
@@ -188,39 +272,53 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
   }
   blockOverviewRendering = false;
 
-  pendingCapture = !g_horzaConfig.prewarmAll;
+  pendingCapture = progressiveOpen || !g_horzaConfig.prewarmAll;
   m_scale->setValueAndWarp(1.0f);
   
   
   openAnimPending = true;
 
   if (Event::bus()) {
+    // With several overviews open, pointer input goes to the one under the
+    // cursor (or the one holding a press) and keys to the one on the focused
+    // monitor.
     mouseMoveHook = Event::bus()->m_events.input.mouse.move.listen(
-        [this](Vector2D coords, SCallbackInfo& info) { onMouseMove(); });
+        [this](Vector2D coords, SCallbackInfo& info) {
+          if (ownsPointerInput())
+            onMouseMove();
+        });
     mouseButtonHook = Event::bus()->m_events.input.mouse.button.listen(
         [this](IPointer::SButtonEvent e, SCallbackInfo& info) {
-          if (closing)
+          if (closing || !ownsPointerInput())
             return;
           info.cancelled = true;
           onMouseButton(e, info);
         });
     mouseAxisHook = Event::bus()->m_events.input.mouse.axis.listen(
         [this](IPointer::SAxisEvent e, SCallbackInfo& info) {
-          onMouseAxis(e, info);
+          if (ownsPointerInput())
+            onMouseAxis(e, info);
         });
     keyPressHook = Event::bus()->m_events.input.keyboard.key.listen(
         [this](IKeyboard::SKeyEvent e, SCallbackInfo& info) {
-          onKeyPress(e, info);
+          if (ownsKeyboardInput())
+            onKeyPress(e, info);
         });
   }
 
   if (Event::bus()) {
     createWorkspaceHook = Event::bus()->m_events.workspace.created.listen(
-        [this](PHLWORKSPACEREF ws) { requestWorkspaceSync(); });
+        [this](PHLWORKSPACEREF ws) { onWorkspaceCreated(ws.lock()); });
     destroyWorkspaceHook = Event::bus()->m_events.workspace.removed.listen(
-        [this](PHLWORKSPACEREF ws) { requestWorkspaceSync(); });
+        [this](PHLWORKSPACEREF ws) { onWorkspaceRemoved(ws.lock()); });
     moveWorkspaceHook = Event::bus()->m_events.workspace.moveToMonitor.listen(
-        [this](PHLWORKSPACE ws, PHLMONITOR mon) { requestWorkspaceSync(); });
+        [this](PHLWORKSPACE ws, PHLMONITOR mon) { onWorkspaceMoved(ws, mon); });
+    windowOpenHook = Event::bus()->m_events.window.open.listen(
+        [this](PHLWINDOW window) { frozenAnimVarsDirty = true; });
+    windowCloseHook = Event::bus()->m_events.window.close.listen(
+        [this](PHLWINDOW window) { frozenAnimVarsDirty = true; });
+    windowMoveHook = Event::bus()->m_events.window.moveToWorkspace.listen(
+        [this](PHLWINDOW window, PHLWORKSPACE ws) { frozenAnimVarsDirty = true; });
     monitorAddedHook = Event::bus()->m_events.monitor.added.listen(
         [this](PHLMONITOR mon) { requestWorkspaceSync(); });
     monitorRemovedHook = Event::bus()->m_events.monitor.removed.listen(
@@ -235,12 +333,18 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool transitMode_,
           onPreRender();
         });
   }
+  listenForPresentation();
 
   ready = true;
 }
 
 COverview::~COverview() {
   saveTilesToCache();
+  retainBackground();
+  if (framesScheduled > 0 || framesPresented > 0)
+    Log::logger->log(Log::DEBUG, "[horza] frame pacing: scheduled={} presented={}",
+                     framesScheduled, framesPresented);
+  presentHook.reset();
   preRenderHook.reset();
   mouseButtonHook.reset();
   mouseMoveHook.reset();
@@ -249,6 +353,9 @@ COverview::~COverview() {
   createWorkspaceHook.reset();
   destroyWorkspaceHook.reset();
   moveWorkspaceHook.reset();
+  windowOpenHook.reset();
+  windowCloseHook.reset();
+  windowMoveHook.reset();
   monitorAddedHook.reset();
   monitorRemovedHook.reset();
   configReloadedHook.reset();
@@ -258,6 +365,7 @@ COverview::~COverview() {
 
 
 void COverview::onPreRender() {
+  CTraceSpan traceSpan("onPreRender");
   passQueuedThisFrame = false;
 
   if (blockOverviewRendering)
@@ -267,13 +375,16 @@ void COverview::onPreRender() {
   if (!PMONITOR)
     return;
 
+  if (g_horzaConfig.adaptiveLivePreview)
+    updatePreviewGovernor();
+
   if (!closing && g_horzaConfig.freezeAnimationsInOverview)
     suppressGlobalAnimations();
 
   if (!closing && (workspaceListDirty || needsWorkspaceSync()) &&
       syncWorkspaces()) {
     if (images.empty() || currentIdx < 0 || currentIdx >= (int)images.size()) {
-      g_pEventLoopManager->doLater([]() { g_pOverview.reset(); });
+      g_pEventLoopManager->doLater([self = this]() { destroyOverview(self); });
       return;
     }
     damage();
@@ -321,6 +432,37 @@ void COverview::onPreRender() {
       onWorkspaceChange();
   }
 
+  applyPointerMotion();
+
+  if (pendingScrollSteps != 0) {
+    const int steps = pendingScrollSteps;
+    pendingScrollSteps = 0;
+    shiftCurrentIndexBy(steps);
+  }
+
+  // A card passed at scroll speed keeps its placeholder; the one the motion
+  // stops on is captured once no step has arrived for a settle window.
+  if (settleCapturePending) {
+    const auto sinceStep = std::chrono::steady_clock::now() - lastSelectionChangeAt;
+    if (!scrollAtSpeed || sinceStep >= std::chrono::milliseconds(120)) {
+      settleCapturePending = false;
+      if (!images[currentIdx].captured && !images[currentIdx].cachedTex) {
+        g_horzaTracer.instant("captureSettled", "idx", currentIdx);
+        blockOverviewRendering = true;
+        images[currentIdx].captured = captureWorkspace(currentIdx);
+        blockOverviewRendering = false;
+        damage();
+        return;
+      }
+    }
+  }
+
+  // Some touchpads never send the axis stop event.
+  if (touchpadGestureActive &&
+      std::chrono::steady_clock::now() - touchpadGestureLastAt >
+          std::chrono::milliseconds(150))
+    settleTouchpadGesture();
+
   const bool deferCaptures = shouldDeferCaptures();
 
   if (openingAnimInProgress()) {
@@ -328,18 +470,49 @@ void COverview::onPreRender() {
     return;
   }
 
+  if (damageDirty) {
+    const bool canUseCurrentCache =
+        currentIdx >= 0 && currentIdx < (int)images.size() &&
+        images[currentIdx].cachedTex;
+    if (deferCaptures && (canUseCurrentCache || touchpadGestureActive)) {
+      // Keep rapid card browsing smooth when we already have a cached preview
+      // for the centered tile.
+      g_horzaTracer.instant("deferCurrentCapture", "idx", currentIdx);
+    } else {
+      g_horzaTracer.instant("captureCurrent", "idx", currentIdx);
+      damageDirty = false;
+      blockOverviewRendering = true;
+      images[currentIdx].captured = captureWorkspace(currentIdx);
+      blockOverviewRendering = false;
+      images[currentIdx].cachedTex.reset();
+      damage();
+      return;
+    }
+  }
+
+  // Without presentation feedback there is no post-present slot; fall back to
+  // capturing ahead of this frame.
+  if (!presentHook.has_value() &&
+      runOptionalCaptures(std::max(0.0f, sharedCaptureBudgetMs()))) {
+    damage();
+    return;
+  }
+
+  if (needsFramePump())
+    pumpFrameIfDue();
+}
+
+
+bool COverview::runOptionalCaptures(float captureBudgetMs) {
+  if (images.empty() || currentIdx < 0 || currentIdx >= (int)images.size())
+    return false;
+
   const auto frameCaptureStart = std::chrono::steady_clock::now();
-  const int maxCapturesPerFrame = std::max(0, g_horzaConfig.maxCapturesPerFrame);
-  const float captureBudgetMs = std::max(0.0f, g_horzaConfig.captureBudgetMs);
+  const bool deferCaptures = shouldDeferCaptures();
+  const int maxCapturesPerFrame = capturesPerFrameNow();
   int optionalCapturesThisFrame = 0;
   const int captureRadius = std::max(0, g_horzaConfig.livePreviewRadius);
-  const auto inCaptureRadius = [&](int idx) {
-    if (idx == currentIdx)
-      return true;
-    if (captureRadius <= 0)
-      return false;
-    return std::abs(idx - currentIdx) <= captureRadius;
-  };
+  const auto stateOf = [this](int i) { return captureStateOf(i); };
   const auto canDoOptionalCapture = [&]() {
     if (optionalCapturesThisFrame >= maxCapturesPerFrame)
       return false;
@@ -353,25 +526,21 @@ void COverview::onPreRender() {
     return elapsedMs < captureBudgetMs;
   };
 
+  if (backgroundRefreshPending && !deferCaptures && canDoOptionalCapture()) {
+    backgroundRefreshPending = false;
+    blockOverviewRendering = true;
+    captureBackground();
+    blockOverviewRendering = false;
+    optionalCapturesThisFrame++;
+    return true;
+  }
+
   if (pendingCapture && !deferCaptures) {
     bool capturedAny = false;
 
     while (canDoOptionalCapture()) {
-      int nextIdx = -1;
-      int bestDist = std::numeric_limits<int>::max();
-      for (int i = 0; i < (int)images.size(); ++i) {
-        if (!inCaptureRadius(i))
-          continue;
-        if (images[i].captured)
-          continue;
-        if (!isTileOnScreen(images[i].displayBox))
-          continue;
-        const int dist = std::abs(i - currentIdx);
-        if (dist < bestDist) {
-          bestDist = dist;
-          nextIdx = i;
-        }
-      }
+      const int nextIdx = pickNearestUncapturedCard((int)images.size(), currentIdx,
+                                                    captureRadius, stateOf);
 
       pendingCapture = nextIdx != -1;
       if (nextIdx == -1)
@@ -387,36 +556,9 @@ void COverview::onPreRender() {
     }
 
     if (capturedAny) {
-      pendingCapture = false;
-      for (int i = 0; i < (int)images.size(); ++i) {
-        if (!inCaptureRadius(i))
-          continue;
-        const auto& img = images[i];
-        if (!img.captured && isTileOnScreen(img.displayBox)) {
-          pendingCapture = true;
-          break;
-        }
-      }
-      damage();
-      return;
-    }
-  }
-
-  if (damageDirty) {
-    const bool canUseCurrentCache =
-        currentIdx >= 0 && currentIdx < (int)images.size() &&
-        images[currentIdx].cachedTex;
-    if (deferCaptures && canUseCurrentCache) {
-      // Keep rapid card browsing smooth when we already have a cached preview
-      // for the centered tile.
-    } else {
-      damageDirty = false;
-      blockOverviewRendering = true;
-      images[currentIdx].captured = captureWorkspace(currentIdx);
-      blockOverviewRendering = false;
-      images[currentIdx].cachedTex.reset();
-      damage();
-      return;
+      pendingCapture = pickNearestUncapturedCard((int)images.size(), currentIdx,
+                                                 captureRadius, stateOf) != -1;
+      return true;
     }
   }
 
@@ -427,7 +569,7 @@ void COverview::onPreRender() {
     const int refreshIdx = damageRefreshIdx;
     const bool shouldRefreshNow =
         refreshIdx == currentIdx ||
-        (inCaptureRadius(refreshIdx) &&
+        (inCaptureRadius(refreshIdx, currentIdx, captureRadius) &&
          isTileOnScreen(images[refreshIdx].displayBox));
 
     if (shouldRefreshNow) {
@@ -436,9 +578,27 @@ void COverview::onPreRender() {
       images[refreshIdx].captured = captureWorkspace(refreshIdx);
       blockOverviewRendering = false;
       images[refreshIdx].cachedTex.reset();
-      damage();
-      return;
+      return true;
+    }
+  }
+
+  if (!closing && !deferCaptures && !captureQueue.empty()) {
+    bool capturedAny = false;
+    while (!captureQueue.empty() && canDoOptionalCapture()) {
+      const int idx = findWorkspaceCardByID(captureQueue.front());
+      captureQueue.pop_front();
+      if (idx == -1 || images[idx].captured)
+        continue;
+
+      blockOverviewRendering = true;
+      images[idx].captured = captureWorkspace(idx);
+      blockOverviewRendering = false;
+      images[idx].cachedTex.reset();
+      optionalCapturesThisFrame++;
+      capturedAny = true;
     }
+    if (capturedAny)
+      return true;
   }
 
   if (!pendingCapture && !closing && !deferCaptures && canDoOptionalCapture()) {
@@ -449,21 +609,110 @@ void COverview::onPreRender() {
       images[visibleRefreshIdx].captured = captureWorkspace(visibleRefreshIdx);
       blockOverviewRendering = false;
       images[visibleRefreshIdx].cachedTex.reset();
-      damage();
-      return;
+      return true;
     }
   }
 
-  if (needsFramePump())
-    pumpFrameIfDue();
+  return false;
+}
+
+bool COverview::ownsPointerInput() const {
+  if (g_overviews.size() <= 1)
+    return true;
+  // The overview that saw a press keeps the pointer until the release, even
+  // when the cursor crosses to another monitor meanwhile.
+  for (const auto& ov : g_overviews) {
+    if (ov->leftButtonDown)
+      return ov.get() == this;
+  }
+  const auto mon = g_pCompositor->getMonitorFromCursor();
+  return mon && mon == pMonitor.lock();
+}
+
+bool COverview::ownsKeyboardInput() const {
+  return g_overviews.size() <= 1 || focusedOverview() == this;
+}
+
+bool COverview::hasMissingCards() const {
+  return pendingCapture || damageDirty || backgroundRefreshPending ||
+         !captureQueue.empty();
+}
+
+float COverview::sharedCaptureBudgetMs() const {
+  if (g_overviews.size() <= 1)
+    return g_horzaConfig.captureBudgetMs;
+
+  const auto focusedMon = Desktop::focusState()->monitor();
+  std::vector<SOutputCaptureDemand> demands;
+  size_t self = 0;
+  for (const auto& ov : g_overviews) {
+    const auto mon = ov->pMonitor.lock();
+    if (ov.get() == this)
+      self = demands.size();
+    demands.push_back({.refreshHz = mon ? mon->m_refreshRate : 60.0f,
+                       .focused = mon && mon == focusedMon,
+                       .missingCards = ov->hasMissingCards()});
+  }
+  return captureBudgetForOutput(g_horzaConfig.captureBudgetMs, demands, self);
 }
 
+void COverview::scheduleIdleCaptureSlot() {
+  if (idleCaptureSlotScheduled)
+    return;
+  idleCaptureSlotScheduled = true;
+  g_pEventLoopManager->doLater([self = this]() {
+    if (overviewAlive(self))
+      self->runIdleCaptureSlot();
+  });
+}
+
+void COverview::runIdleCaptureSlot() {
+  CTraceSpan traceSpan("idleCaptureSlot");
+  idleCaptureSlotScheduled = false;
+  if (!ready || closing || blockOverviewRendering || closeDropScheduled)
+    return;
+  if (openingAnimInProgress() && !progressiveOpen)
+    return;
+
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return;
+
+  // Spend what is left of this refresh interval, never more than the budget.
+  const float refreshHz = std::clamp(PMONITOR->m_refreshRate, 30.0f, 240.0f);
+  const float intervalMs = 1000.0f / refreshHz;
+  const float sincePresentMs =
+      std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() -
+                                               lastPresentedAt)
+          .count();
+  float budgetMs = intervalMs * 0.75f - sincePresentMs;
+  if (g_horzaConfig.captureBudgetMs > 0.0f)
+    budgetMs = std::min(budgetMs, sharedCaptureBudgetMs());
+
+  // Under sustained load there is never headroom; let one capture through
+  // every few frames so cards still fill in.
+  if (budgetMs <= 0.0f) {
+    if (++idleCaptureSlotSkips < 4)
+      return;
+    budgetMs = 0.001f;
+  }
+  idleCaptureSlotSkips = 0;
+
+  if (runOptionalCaptures(budgetMs))
+    damage();
+}
 
 void COverview::close() {
   if (closing)
     return;
 
   closing = true;
+  captureQueue.clear();
+  // Overviews on other monitors open and close together.
+  for (const auto& other : g_overviews) {
+    if (other.get() != this && !transitMode && !other->transitMode)
+      other->close();
+  }
   closeStartedAt = std::chrono::steady_clock::now();
   closeAnimFinishedAt = {};
   closeDropScheduled = false;
@@ -484,14 +733,11 @@ void COverview::close() {
   *m_crossOffset = 0.0f;
   *m_scale = 1.0f;
   m_scale->setCallbackOnEnd(
-      [](WP<Hyprutils::Animation::CBaseAnimatedVariable> var) {
-        if (!g_pOverview)
-          return;
+      [this](WP<Hyprutils::Animation::CBaseAnimatedVariable> var) {
+        if (closeAnimFinishedAt.time_since_epoch().count() == 0)
+          closeAnimFinishedAt = std::chrono::steady_clock::now();
 
-        if (g_pOverview->closeAnimFinishedAt.time_since_epoch().count() == 0)
-          g_pOverview->closeAnimFinishedAt = std::chrono::steady_clock::now();
-
-        g_pOverview->damage();
+        damage();
       });
 }
 
@@ -500,6 +746,10 @@ void COverview::reopen() {
     return;
 
   closing = false;
+  for (const auto& other : g_overviews) {
+    if (other.get() != this && !transitMode && !other->transitMode)
+      other->reopen();
+  }
   closeStartedAt = {};
   closeAnimFinishedAt = {};
   closeDropScheduled = false;
@@ -520,7 +770,7 @@ void COverview::render() {
   if (passQueuedThisFrame)
     return;
   passQueuedThisFrame = true;
-  g_pHyprRenderer->m_renderPass.add(makeUnique<COverviewPassElement>());
+  g_pHyprRenderer->m_renderPass.add(makeUnique<COverviewPassElement>(this));
 }
 
 
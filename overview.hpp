@@ -1,7 +1,13 @@
 #pragma once
 #include "config.hpp"
+#include "core/capture_schedule.hpp"
+#include "core/layout.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include <array>
 #include <any>
 #include <chrono>
+#include <deque>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/devices/IKeyboard.hpp>
 #include <hyprland/src/devices/IPointer.hpp>
@@ -9,6 +15,8 @@
 #include <hyprland/src/helpers/AnimatedVariable.hpp>
 #include <hyprland/src/render/Framebuffer.hpp>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using SCallbackInfo = Event::SCallbackInfo;
@@ -30,12 +38,17 @@ public:
   void reopen();
   void requestWorkspaceSync();
   bool closeDropPending() const;
+  void notePendingInput(eInputLatencyKind kind,
+                        std::chrono::steady_clock::time_point at);
+  size_t framebufferBytes() const;
+  bool hasMissingCards() const;
 
   bool ready = false;
   bool closing = false;
   bool transitMode = false;
 
   std::any preRenderHook;
+  std::any presentHook;
   std::any mouseButtonHook;
   std::any mouseMoveHook;
   std::any mouseAxisHook;
@@ -43,6 +56,9 @@ public:
   std::any createWorkspaceHook;
   std::any destroyWorkspaceHook;
   std::any moveWorkspaceHook;
+  std::any windowOpenHook;
+  std::any windowCloseHook;
+  std::any windowMoveHook;
   std::any monitorAddedHook;
   std::any monitorRemovedHook;
   std::any configReloadedHook;
@@ -55,17 +71,37 @@ public:
 private:
   void onMouseButton(const IPointer::SButtonEvent& e, SCallbackInfo& info);
   void onMouseMove();
+  void applyPointerMotion();
   void onMouseAxis(const IPointer::SAxisEvent& e, SCallbackInfo& info);
   void onKeyPress(const IKeyboard::SKeyEvent& e, SCallbackInfo& info);
+  bool handleNavigationKey(xkb_keysym_t keysym);
+  void commitSelection();
+  bool ownsPointerInput() const;
+  bool ownsKeyboardInput() const;
+  float sharedCaptureBudgetMs() const;
   void onWorkspaceChange();
   bool syncWorkspaces();
   bool needsWorkspaceSync();
+  int findWorkspaceCardByID(int64_t workspaceID) const;
+  int findWorkspaceCard(const PHLWORKSPACE& ws) const;
+  // `first` puts the card ahead of everything already queued.
+  void queueWorkspaceCapture(int idx, bool first = false);
+  void insertWorkspaceCard(const PHLWORKSPACE& ws);
+  void removeWorkspaceCard(int idx);
+  void markWorkspaceListDirty();
+  void onWorkspaceCreated(const PHLWORKSPACE& ws);
+  void onWorkspaceRemoved(const PHLWORKSPACE& ws);
+  void onWorkspaceMoved(const PHLWORKSPACE& ws, const PHLMONITOR& mon);
   bool shiftCurrentIndexBy(int step);
+  float stripPitch() const;
+  void followTouchpadGesture(double delta, std::chrono::steady_clock::time_point at);
+  void settleTouchpadGesture();
   int hitTileIndex(const Vector2D& localPos) const;
   Vector2D tileLocalToWorkspacePos(const CBox& tileBox,
                                    const Vector2D& localPos) const;
-  PHLWINDOW pickWindowInWorkspace(const PHLWORKSPACE& ws,
-                                  const Vector2D& workspacePos) const;
+  PHLWINDOW pickWindowInWorkspace(int idx, const Vector2D& workspacePos,
+                                  CBox* outBox = nullptr);
+  void snapshotWindowBoxes(int idx);
   void clearDragState();
   bool restoreTileFromCache(int idx);
   void saveTilesToCache();
@@ -76,44 +112,89 @@ private:
   bool needsFramePump() const;
   bool framePumpDue(std::chrono::steady_clock::time_point now) const;
   void pumpFrameIfDue(bool force = false);
+  void listenForPresentation();
+  void onOutputPresented(bool presented);
+  bool runOptionalCaptures(float captureBudgetMs);
+  void scheduleIdleCaptureSlot();
+  void runIdleCaptureSlot();
   bool isTileOnScreen(const CBox& box) const;
+  SCardCaptureState captureStateOf(int idx) const;
+  void updatePreviewGovernor();
+  float livePreviewFpsNow() const;
+  int capturesPerFrameNow() const;
   int pickVisibleLivePreviewWorkspace(
       std::chrono::steady_clock::time_point now) const;
   std::string workspaceTitleFor(const PHLWORKSPACE& ws) const;
-  void suppressGlobalAnimations() const;
+  void suppressGlobalAnimations();
+  void freezeMonitorAnimations();
   void suppressWorkspaceWindowAnimations(const PHLWORKSPACE& ws) const;
   bool captureWorkspace(int idx);
+  bool captureFromPresentedFrame(int idx);
+  // `srcTex` is the texture the card was just captured or restored into.
+  void buildReducedLevel(int idx, const SP<CTexture>& srcTex);
   void captureBackground();
+  void retainBackground();
+  bool restoreRetainedBackground();
   void refreshCardShadowTexture();
   void renderWorkspaceTitle(int idx, const CRegion& dmg, float tileScale);
   void scheduleCloseDrop();
+  void flushInputLatency();
+
+  struct SWindowHitBox {
+    PHLWINDOWREF window;
+    CBox box; // monitor-local, logical px
+  };
 
   struct SWorkspaceImage {
-    CFramebuffer fb;
+    SP<CFramebuffer> fb;
+    uint32_t fbFormat = 0;
     PHLWORKSPACE pWorkspace;
     CBox displayBox;
     bool captured = false;
     std::chrono::steady_clock::time_point lastCaptureAt{};
     SP<CTexture> cachedTex;
+    SP<CFramebuffer> reducedFb;
+    uint32_t reducedFbFormat = 0;
+    bool reducedValid = false;
+    std::chrono::steady_clock::time_point reducedFromCaptureAt{};
     SP<CTexture> titleTex;
     std::string titleTextCached;
     int titleMaxWidthCached = 0;
     int titleFontCached = 0;
     std::string titleFontFamilyCached;
+    // Topmost first; taken alongside the card texture so picks match what is drawn.
+    std::vector<SWindowHitBox> windowBoxes;
+    bool windowBoxesValid = false;
   };
 
   std::vector<SWorkspaceImage> images;
   int currentIdx = 0;
+  SStripLayout layout;
   bool damageDirty = false;
   int damageRefreshIdx = -1;
   bool pendingCapture = false;
+  // Workspace IDs waiting for a budgeted capture, oldest first.
+  std::deque<int64_t> captureQueue;
   bool workspaceListDirty = false;
   std::chrono::steady_clock::time_point nextWorkspaceSyncPollAt{};
   bool openAnimPending = false;
+  // Opened with a first-frame deadline: captures may run during the open
+  // animation.
+  bool progressiveOpen = false;
   bool backgroundCaptured = false;
+  bool backgroundRefreshPending = false;
+  // Animated variables on this monitor that freeze_animations_in_overview
+  // keeps at their goal; rebuilt when windows or workspaces come, go or move.
+  // The weak pointer tells a live entry from a reused address.
+  std::unordered_map<const Hyprutils::Animation::CBaseAnimatedVariable*,
+                     WP<Hyprutils::Animation::CBaseAnimatedVariable>>
+      frozenAnimVars;
+  std::vector<SP<Hyprutils::Animation::CBaseAnimatedVariable>> frozenAnimStarted;
+  bool frozenAnimVarsDirty = true;
   bool directScanoutWasBlocked = false;
   int64_t lastActiveWorkspaceID = -1;
-  CFramebuffer backgroundFb;
+  SP<CFramebuffer> backgroundFb;
+  uint32_t backgroundFbFormat = 0;
   SP<CTexture> cardShadowTex;
   std::string cardShadowTexConfigPath;
   std::string cardShadowTexResolvedPath;
@@ -126,7 +207,22 @@ private:
   Vector2D dragWindowSizeWorkspace = {};
   Vector2D dragWindowGrabOffsetWorkspace = {};
   double scrollGestureAccum = 0.0;
+  // Navigation keys whose press was consumed; their release is swallowed too.
+  std::unordered_set<uint32_t> handledNavigationKeys;
+  // Scroll steps received since the last frame, applied in onPreRender.
+  int pendingScrollSteps = 0;
+  bool scrollAtSpeed = false;
+  std::chrono::steady_clock::time_point lastScrollStepAt{};
+  // The centre card has nothing to show and waits for the selection to settle.
+  bool settleCapturePending = false;
+  // touchpad_follow: the strip tracks the fingers until the swipe ends.
+  bool touchpadGestureActive = false;
+  float touchpadGestureVelocity = 0.0f; // strip px per ms, smoothed
+  std::chrono::steady_clock::time_point touchpadGestureLastAt{};
   bool leftButtonDown = false;
+  // Motion seen since the last frame; first event time for latency.
+  bool pointerMotionPending = false;
+  std::chrono::steady_clock::time_point pointerMotionAt{};
   bool draggingWindow = false;
   int dragSourceIdx = -1;
   int dragTargetIdx = -1;
@@ -135,6 +231,20 @@ private:
   bool closeDropScheduled = false;
   bool passQueuedThisFrame = false;
   std::chrono::steady_clock::time_point lastFramePumpAt{};
+  bool framePumpArmed = false;
+  std::chrono::steady_clock::time_point lastPresentedAt{};
+  bool idleCaptureSlotScheduled = false;
+  int idleCaptureSlotSkips = 0;
+  uint64_t framesScheduled = 0;
+  uint64_t framesPresented = 0;
+  float frameWorkMs = 0.0f;
+  float frameWorkEmaMs = -1.0f;
+  float governedPreviewFps = -1.0f;
+  int governedCapturesPerFrame = -1;
+  std::chrono::steady_clock::time_point governorNextStepAt{};
+  // Earliest input per kind whose state change has not been drawn yet.
+  std::array<std::chrono::steady_clock::time_point, INPUT_LATENCY_KIND_COUNT>
+      pendingInputAt{};
   std::chrono::steady_clock::time_point lastSelectionChangeAt{};
   std::chrono::steady_clock::time_point closeStartedAt{};
   std::chrono::steady_clock::time_point closeAnimFinishedAt{};
@@ -146,4 +256,29 @@ private:
   friend class COverviewPassElement;
 };
 
-inline std::unique_ptr<COverview> g_pOverview;
+// Open overviews, at most one per monitor. all_monitors opens one on every
+// monitor; otherwise only the focused monitor gets one.
+inline std::vector<std::unique_ptr<COverview>> g_overviews;
+
+COverview* overviewForMonitor(const CMonitor* mon);
+// The overview on the focused monitor, else the first one open.
+COverview* focusedOverview();
+bool overviewAlive(const COverview* ov);
+void destroyOverview(const COverview* ov);
+
+void workspaceTileCacheUsage(size_t& outEntries, size_t& outBytes);
+// Marks tiles of the workspace captured before now as outdated.
+void noteWorkspaceContentChanged(int64_t workspaceID);
+void forgetWorkspaceContent(int64_t workspaceID);
+// Whether the cache holds a usable tile that is not outdated or was captured
+// at most maxAgeMs ago. Does not count as a cache lookup or change the
+// entry's recency.
+bool cachedWorkspaceTileFresh(int monitorID, int64_t workspaceID, float maxAgeMs);
+// Stores a snapshot of `ws` in the tile cache while no overview is open.
+bool captureLeavingWorkspace(const PHLMONITOR& mon, const PHLWORKSPACE& ws);
+// Whether the workspace's slide and fade are at rest.
+bool workspaceSettled(const PHLWORKSPACE& ws);
+// Renders the first candidate whose cached tile is missing or outdated.
+// Renders at most one workspace; returns whether it did.
+bool prefetchWorkspaceTile(const PHLMONITOR& mon,
+                           const std::vector<PHLWORKSPACE>& candidates);
@@ -1,5 +1,7 @@
 // Overview capture pipeline (workspace/background framebuffer capture + tile cache).
 #include "overview.hpp"
+#include "core/tile_cache.hpp"
+#include "plugin_runtime.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
@@ -9,40 +11,44 @@
 
 #define private public
 #include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/config/ConfigValue.hpp>
 #include <hyprland/src/debug/log/Logger.hpp>
+#include <hyprland/src/helpers/Format.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/managers/PointerManager.hpp>
 #include <hyprland/src/managers/animation/DesktopAnimationManager.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/render/Renderer.hpp>
 #undef private
 
-struct STileCacheKey {
-  int monitorID = -1;
-  int64_t workspaceID = -1;
-
-  bool operator==(const STileCacheKey& other) const = default;
+// Cache entries own their framebuffer; an open overview renders recaptures
+// straight into the restored framebuffer.
+struct SCachedTile {
+  SP<CFramebuffer> fb;
+  uint32_t format = 0;
 };
 
-struct STileCacheKeyHash {
-  size_t operator()(const STileCacheKey& key) const noexcept {
-    const size_t h1 = std::hash<int>{}(key.monitorID);
-    const size_t h2 = std::hash<int64_t>{}(key.workspaceID);
-    return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6U) + (h1 >> 2U));
-  }
-};
+static CTileCache<SCachedTile> g_workspaceTileCache;
 
-struct STileCacheEntry {
-  SP<CTexture> tex;
-  std::chrono::steady_clock::time_point capturedAt{};
-  std::chrono::steady_clock::time_point cachedAt{};
-};
+// When each workspace last changed in a way its tile cannot show: a window
+// opened, closed or moved, or the workspace was shown or left. Hidden
+// workspaces get no frame callbacks, so their clients rarely redraw.
+static std::unordered_map<int64_t, std::chrono::steady_clock::time_point>
+    g_workspaceChangedAt;
 
-static std::unordered_map<STileCacheKey, STileCacheEntry, STileCacheKeyHash>
-    g_workspaceTileCache;
+static bool tileOutdated(int64_t workspaceID,
+                         const CTileCache<SCachedTile>::SEntry& entry) {
+  const auto it = g_workspaceChangedAt.find(workspaceID);
+  return it != g_workspaceChangedAt.end() && entry.capturedAt < it->second;
+}
 
 static bool isRenderableTexture(const SP<CTexture>& tex);
 
+static bool isLiveTile(const SCachedTile& tile) {
+  return tile.fb && isRenderableTexture(tile.fb->getTexture());
+}
+
 static bool tileCacheEnabled() {
   return g_horzaConfig.persistentCache && g_horzaConfig.cacheTtlMs > 0.0f;
 }
@@ -53,76 +59,98 @@ static void pruneWorkspaceTileCache() {
     return;
   }
 
-  const auto now = std::chrono::steady_clock::now();
-  const auto ttl = std::chrono::duration<float, std::milli>(g_horzaConfig.cacheTtlMs);
-
-  for (auto it = g_workspaceTileCache.begin(); it != g_workspaceTileCache.end();) {
-    const bool deadTex = !isRenderableTexture(it->second.tex);
-    const bool expired = now - it->second.cachedAt > ttl;
-    if (deadTex || expired)
-      it = g_workspaceTileCache.erase(it);
-    else
-      ++it;
-  }
-
-  const int maxEntries = std::max(0, g_horzaConfig.cacheMaxEntries);
-  while ((int)g_workspaceTileCache.size() > maxEntries) {
-    auto oldestIt = g_workspaceTileCache.end();
-    for (auto it = g_workspaceTileCache.begin(); it != g_workspaceTileCache.end();
-         ++it) {
-      if (oldestIt == g_workspaceTileCache.end() ||
-          it->second.cachedAt < oldestIt->second.cachedAt)
-        oldestIt = it;
-    }
-
-    if (oldestIt == g_workspaceTileCache.end())
-      break;
-    g_workspaceTileCache.erase(oldestIt);
-  }
+  const auto ttl = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<float, std::milli>(g_horzaConfig.cacheTtlMs));
+  g_horzaStats.tileCacheEvictions += g_workspaceTileCache.prune(
+      std::chrono::steady_clock::now(), ttl,
+      (size_t)std::max(0, g_horzaConfig.cacheMaxEntries), isLiveTile);
 }
 
 static void storeWorkspaceTileInCache(
-    int monitorID, int64_t workspaceID, const SP<CTexture>& tex,
+    int monitorID, int64_t workspaceID, const SCachedTile& tile,
     std::chrono::steady_clock::time_point capturedAt) {
   if (!tileCacheEnabled())
     return;
-  if (!isRenderableTexture(tex))
+  if (!isLiveTile(tile))
     return;
 
   pruneWorkspaceTileCache();
-
-  const auto now = std::chrono::steady_clock::now();
-  g_workspaceTileCache[{monitorID, workspaceID}] = {
-      .tex = tex,
-      .capturedAt = capturedAt.time_since_epoch().count() == 0 ? now : capturedAt,
-      .cachedAt = now,
-  };
-
+  g_workspaceTileCache.store({monitorID, workspaceID}, tile, capturedAt,
+                             std::chrono::steady_clock::now());
+  g_horzaStats.tileCacheStores++;
   pruneWorkspaceTileCache();
 }
 
 static bool restoreWorkspaceTileFromCache(
-    int monitorID, int64_t workspaceID, SP<CTexture>& outTex,
+    int monitorID, int64_t workspaceID, SCachedTile& outTile,
     std::chrono::steady_clock::time_point& outCapturedAt) {
   if (!tileCacheEnabled())
     return false;
 
   pruneWorkspaceTileCache();
 
-  const auto it = g_workspaceTileCache.find({monitorID, workspaceID});
-  if (it == g_workspaceTileCache.end())
+  const STileCacheKey key{monitorID, workspaceID};
+  const auto* entry =
+      g_workspaceTileCache.touch(key, std::chrono::steady_clock::now());
+  if (!entry) {
+    g_horzaStats.tileCacheMisses++;
     return false;
-  if (!isRenderableTexture(it->second.tex)) {
-    g_workspaceTileCache.erase(it);
+  }
+  if (!isLiveTile(entry->payload)) {
+    g_workspaceTileCache.erase(key);
+    g_horzaStats.tileCacheEvictions++;
+    g_horzaStats.tileCacheMisses++;
     return false;
   }
 
-  it->second.cachedAt = std::chrono::steady_clock::now();
-  outTex = it->second.tex;
-  outCapturedAt = it->second.capturedAt;
+  g_horzaStats.tileCacheHits++;
+  outTile = entry->payload;
+  outCapturedAt = entry->capturedAt;
   return true;
 }
 
+static size_t bytesPerPixel(uint32_t drmFormat) {
+  switch (drmFormat) {
+  case DRM_FORMAT_RGB565:
+  case DRM_FORMAT_BGR565:
+    return 2;
+  case DRM_FORMAT_XRGB16161616F:
+  case DRM_FORMAT_ARGB16161616F:
+  case DRM_FORMAT_XBGR16161616F:
+  case DRM_FORMAT_ABGR16161616F:
+    return 8;
+  default:
+    return 4;
+  }
+}
+
+static size_t framebufferBytesOf(const CFramebuffer& fb, uint32_t drmFormat) {
+  if (fb.m_size.x <= 0 || fb.m_size.y <= 0)
+    return 0;
+  return (size_t)fb.m_size.x * (size_t)fb.m_size.y * bytesPerPixel(drmFormat);
+}
+
+void workspaceTileCacheUsage(size_t& outEntries, size_t& outBytes) {
+  outEntries = g_workspaceTileCache.size();
+  outBytes = 0;
+  g_workspaceTileCache.forEach([&](const STileCacheKey&, const auto& entry) {
+    if (entry.payload.fb)
+      outBytes += framebufferBytesOf(*entry.payload.fb, entry.payload.format);
+  });
+}
+
+size_t COverview::framebufferBytes() const {
+  size_t bytes =
+      backgroundFb ? framebufferBytesOf(*backgroundFb, backgroundFbFormat) : 0;
+  for (const auto& img : images) {
+    if (img.fb)
+      bytes += framebufferBytesOf(*img.fb, img.fbFormat);
+    if (img.reducedFb)
+      bytes += framebufferBytesOf(*img.reducedFb, img.reducedFbFormat);
+  }
+  return bytes;
+}
+
 static bool isRenderableTexture(const SP<CTexture>& tex) {
   if (!tex)
     return false;
@@ -142,6 +170,103 @@ static uint32_t pickSafeRenderFormat(const PHLMONITOR& mon) {
   return fmt;
 }
 
+// Cards are opaque thumbnails, so the compact mode drops alpha and precision.
+// The blurred background is a large gradient that bands badly at 16 bpp; it
+// stays at 8 bits per channel in compact mode.
+static uint32_t pickCaptureFormat(const PHLMONITOR& mon, bool background) {
+  const auto& mode = g_horzaConfig.captureFormat;
+  if (mode == "8bit")
+    return DRM_FORMAT_ARGB8888;
+  if (mode == "compact")
+    return background ? DRM_FORMAT_ARGB8888 : DRM_FORMAT_RGB565;
+  return pickSafeRenderFormat(mon);
+}
+
+// CFramebuffer::alloc asserts when the framebuffer comes out incomplete, and
+// not every GL driver can render into every format. Each format is probed
+// once with a 1x1 attachment before captures use it.
+static std::unordered_map<uint32_t, bool> g_formatRenderable;
+
+static bool formatRenderable(uint32_t drmFormat) {
+  if (drmFormat == DRM_FORMAT_ARGB8888)
+    return true;
+  if (const auto it = g_formatRenderable.find(drmFormat);
+      it != g_formatRenderable.end())
+    return it->second;
+
+  bool renderable = false;
+  if (const auto* fmt = NFormatUtils::getPixelFormatFromDRM(drmFormat)) {
+    g_pHyprRenderer->makeEGLCurrent();
+    GLint oldFb = 0, oldTex = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &oldFb);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTex);
+
+    GLuint tex = 0, fb = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0,
+                 fmt->glInternalFormat ? fmt->glInternalFormat : fmt->glFormat,
+                 1, 1, 0, fmt->glFormat, fmt->glType, nullptr);
+    glGenFramebuffers(1, &fb);
+    glBindFramebuffer(GL_FRAMEBUFFER, fb);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           tex, 0);
+    renderable =
+        glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, oldFb);
+    glBindTexture(GL_TEXTURE_2D, oldTex);
+    glDeleteFramebuffers(1, &fb);
+    glDeleteTextures(1, &tex);
+  }
+
+  if (!renderable)
+    Log::logger->log(Log::WARN,
+                     "[horza] capture format {} not renderable, using ARGB8888",
+                     drmFormat);
+  g_formatRenderable[drmFormat] = renderable;
+  return renderable;
+}
+
+// `fbFormat` always holds the format `fb` was allocated with.
+static bool ensureCaptureFramebuffer(CFramebuffer& fb, uint32_t& fbFormat,
+                                     const CBox& box, const PHLMONITOR& mon,
+                                     bool background) {
+  uint32_t format = pickCaptureFormat(mon, background);
+  if (!formatRenderable(format))
+    format = DRM_FORMAT_ARGB8888;
+  if (fb.m_size == box.size() && fbFormat == format)
+    return true;
+
+  fb.release();
+  fbFormat = 0;
+  if (!fb.alloc(box.w, box.h, format))
+    return false;
+  fbFormat = format;
+  return true;
+}
+
+void noteWorkspaceContentChanged(int64_t workspaceID) {
+  if (workspaceID >= 0)
+    g_workspaceChangedAt[workspaceID] = std::chrono::steady_clock::now();
+}
+
+void forgetWorkspaceContent(int64_t workspaceID) {
+  g_workspaceChangedAt.erase(workspaceID);
+}
+
+bool cachedWorkspaceTileFresh(int monitorID, int64_t workspaceID, float maxAgeMs) {
+  if (!tileCacheEnabled() || maxAgeMs <= 0.0f)
+    return false;
+  const auto* entry = g_workspaceTileCache.find({monitorID, workspaceID});
+  if (!entry || !isLiveTile(entry->payload))
+    return false;
+  if (!tileOutdated(workspaceID, *entry))
+    return true;
+  return std::chrono::steady_clock::now() - entry->capturedAt <=
+         std::chrono::duration<float, std::milli>(maxAgeMs);
+}
+
 bool COverview::restoreTileFromCache(int idx) {
   if (idx < 0 || idx >= (int)images.size())
     return false;
@@ -152,15 +277,19 @@ bool COverview::restoreTileFromCache(int idx) {
   if (!PWORKSPACE)
     return false;
 
-  SP<CTexture> cachedTex;
+  SCachedTile tile;
   std::chrono::steady_clock::time_point capturedAt{};
-  if (!restoreWorkspaceTileFromCache(PMONITOR->m_id, PWORKSPACE->m_id, cachedTex,
+  if (!restoreWorkspaceTileFromCache(PMONITOR->m_id, PWORKSPACE->m_id, tile,
                                      capturedAt))
     return false;
 
-  images[idx].cachedTex = cachedTex;
+  images[idx].fb = tile.fb;
+  images[idx].fbFormat = tile.format;
+  images[idx].cachedTex = tile.fb->getTexture();
   images[idx].lastCaptureAt = capturedAt;
   images[idx].captured = false;
+  snapshotWindowBoxes(idx);
+  buildReducedLevel(idx, images[idx].cachedTex);
   return true;
 }
 
@@ -172,20 +301,173 @@ void COverview::saveTilesToCache() {
     return;
 
   for (auto& img : images) {
-    if (!img.pWorkspace)
+    if (!img.pWorkspace || !img.fb)
       continue;
-
-    auto tex = img.cachedTex;
-    if (!isRenderableTexture(tex))
+    if (!img.captured && !img.cachedTex)
       continue;
 
-    storeWorkspaceTileInCache(PMONITOR->m_id, img.pWorkspace->m_id, tex,
+    storeWorkspaceTileInCache(PMONITOR->m_id, img.pWorkspace->m_id,
+                              {.fb = img.fb, .format = img.fbFormat},
                               img.lastCaptureAt);
   }
 }
 
+// Renders `ws` into `fb` as if it were the monitor's active workspace. With
+// keepAnimations the workspace's offset and alpha are warped for the render
+// and back afterwards, which is only exact for a workspace that is not
+// animating; callers check workspaceSettled first.
+static void renderWorkspaceSnapshot(const PHLMONITOR& mon, const PHLWORKSPACE& ws,
+                                    CFramebuffer& fb, const CBox& box,
+                                    bool keepAnimations) {
+  CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
+  g_pHyprRenderer->beginRender(mon, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr,
+                               &fb);
+
+  g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
+
+  const bool oldBlockSurfaceFeedback = g_pHyprRenderer->m_bBlockSurfaceFeedback;
+  g_pHyprRenderer->m_bBlockSurfaceFeedback = true;
+
+  const auto oldActiveWorkspace = mon->m_activeWorkspace;
+  const auto oldActiveSpecialWorkspace = mon->m_activeSpecialWorkspace;
+  const bool targetIsOldActive = oldActiveWorkspace == ws;
+
+  const bool oldVisible = ws->m_visible;
+  const bool oldForceRendering = ws->m_forceRendering;
+
+  if (mon->m_activeSpecialWorkspace)
+    mon->m_activeSpecialWorkspace.reset();
+  if (oldActiveWorkspace && !targetIsOldActive)
+    oldActiveWorkspace->m_visible = false;
+
+  mon->m_activeWorkspace = ws;
+  const auto offsetValue = ws->m_renderOffset->value();
+  const float alphaValue = ws->m_alpha->value();
+  if (keepAnimations) {
+    ws->m_renderOffset->setValueAndWarp(Vector2D{});
+    ws->m_alpha->setValueAndWarp(1.0f);
+  } else if (!targetIsOldActive) {
+    g_pDesktopAnimationManager->startAnimation(
+        ws, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
+  }
+  ws->m_visible = true;
+  ws->m_forceRendering = true;
+
+  g_pHyprRenderer->renderWorkspace(mon, ws, Time::steadyNow(), box);
+
+  ws->m_forceRendering = oldForceRendering;
+  ws->m_visible = oldVisible;
+  if (keepAnimations) {
+    ws->m_renderOffset->setValueAndWarp(offsetValue);
+    ws->m_alpha->setValueAndWarp(alphaValue);
+  } else if (!targetIsOldActive) {
+    g_pDesktopAnimationManager->startAnimation(
+        ws, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+  }
+
+  mon->m_activeWorkspace = oldActiveWorkspace;
+  mon->m_activeSpecialWorkspace = oldActiveSpecialWorkspace;
+  if (oldActiveWorkspace && !targetIsOldActive)
+    oldActiveWorkspace->m_visible = true;
+
+  g_pHyprRenderer->m_bBlockSurfaceFeedback = oldBlockSurfaceFeedback;
+
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+}
+
+bool workspaceSettled(const PHLWORKSPACE& ws) {
+  return ws && !ws->m_renderOffset->isBeingAnimated() &&
+         !ws->m_alpha->isBeingAnimated();
+}
+
+// Card-sized snapshot of `ws` into its tile cache entry, for a workspace that
+// is not shown by an overview. Records the render time into `histogram`.
+static bool snapshotWorkspaceIntoCache(const PHLMONITOR& mon, const PHLWORKSPACE& ws,
+                                       CLatencyHistogram& histogram) {
+  if (!workspaceSettled(ws))
+    return false;
+  const auto now = std::chrono::steady_clock::now();
+
+  // Reuse the workspace's cached framebuffer when it has one.
+  SCachedTile tile;
+  if (const auto* entry = g_workspaceTileCache.touch({mon->m_id, ws->m_id}, now))
+    tile = entry->payload;
+  if (!tile.fb)
+    tile.fb = makeShared<CFramebuffer>();
+
+  // A card-sized snapshot is enough until the overview recaptures it.
+  const float scale =
+      std::min(clampCaptureScale(g_horzaConfig.captureScale),
+               std::clamp(effectiveDisplayScale(g_horzaConfig.displayScale), 0.05f, 1.0f));
+  const CBox box = {0.0, 0.0,
+                    (double)std::max(1, (int)std::round(mon->m_pixelSize.x * scale)),
+                    (double)std::max(1, (int)std::round(mon->m_pixelSize.y * scale))};
+
+  // Nothing on screen changes, so neither a leave snapshot nor a prefetch
+  // may schedule a frame.
+  if (!g_pPluginRuntime || !g_pPluginRuntime->installFunctionHooks())
+    return false;
+
+  g_pHyprRenderer->makeEGLCurrent();
+  if (!ensureCaptureFramebuffer(*tile.fb, tile.format, box, mon, false)) {
+    g_horzaStats.captureFailures++;
+    return false;
+  }
+
+  g_pPluginRuntime->blockSnapshotDamage = true;
+  renderWorkspaceSnapshot(mon, ws, *tile.fb, box, true);
+  g_pPluginRuntime->blockSnapshotDamage = false;
+
+  const auto capturedAt = std::chrono::steady_clock::now();
+  histogram.record(std::chrono::duration<float, std::milli>(capturedAt - now).count());
+  if (!isLiveTile(tile)) {
+    g_horzaStats.captureFailures++;
+    return false;
+  }
+  storeWorkspaceTileInCache(mon->m_id, ws->m_id, tile, capturedAt);
+  return true;
+}
+
+static bool canSnapshotClosedWorkspace(const PHLMONITOR& mon, const PHLWORKSPACE& ws) {
+  if (!mon || !ws || ws->m_isSpecialWorkspace || ws->m_id < 0)
+    return false;
+  return mon->m_pixelSize.x > 0 && mon->m_pixelSize.y > 0;
+}
+
+bool captureLeavingWorkspace(const PHLMONITOR& mon, const PHLWORKSPACE& ws) {
+  if (!g_horzaConfig.captureOnLeave || !tileCacheEnabled())
+    return false;
+  if (!canSnapshotClosedWorkspace(mon, ws))
+    return false;
+
+  CTraceSpan traceSpan("captureLeavingWorkspace", "ws", ws->m_id);
+  return snapshotWorkspaceIntoCache(mon, ws, g_horzaStats.leaveCaptureMs);
+}
+
+bool prefetchWorkspaceTile(const PHLMONITOR& mon,
+                           const std::vector<PHLWORKSPACE>& candidates) {
+  if (!tileCacheEnabled() || g_horzaConfig.transitCacheMaxAgeMs <= 0.0f)
+    return false;
+
+  // Only missing or outdated tiles are rendered; current ones are touched so
+  // the cache's TTL keeps them while they are prefetch candidates.
+  const auto now = std::chrono::steady_clock::now();
+  for (const auto& ws : candidates) {
+    if (!canSnapshotClosedWorkspace(mon, ws) || !workspaceSettled(ws))
+      continue;
+    const auto* entry = g_workspaceTileCache.touch({mon->m_id, ws->m_id}, now);
+    if (entry && isLiveTile(entry->payload) && !tileOutdated(ws->m_id, *entry))
+      continue;
+
+    CTraceSpan traceSpan("prefetchWorkspaceTile", "ws", ws->m_id);
+    return snapshotWorkspaceIntoCache(mon, ws, g_horzaStats.prefetchCaptureMs);
+  }
+  return false;
+}
 
 bool COverview::captureWorkspace(int idx) {
+  CTraceSpan traceSpan("captureWorkspace", "idx", idx);
   if (idx < 0 || idx >= (int)images.size())
     return false;
   const auto PMONITOR = pMonitor.lock();
@@ -202,6 +484,7 @@ bool COverview::captureWorkspace(int idx) {
 
   blockDamageReporting = true;
 
+  const auto captureStartedAt = std::chrono::steady_clock::now();
   auto &img = images[idx];
   if (!img.pWorkspace) {
     Log::logger->log(Log::ERR, "[horza] captureWorkspace: null workspace at idx={}",
@@ -211,6 +494,8 @@ bool COverview::captureWorkspace(int idx) {
   }
 
   img.cachedTex.reset();
+  if (!img.fb)
+    img.fb = makeShared<CFramebuffer>();
 
   const float captureScale = clampCaptureScale(g_horzaConfig.captureScale);
   const int captureW =
@@ -221,83 +506,204 @@ bool COverview::captureWorkspace(int idx) {
 
   g_pHyprRenderer->makeEGLCurrent();
 
-  if (img.fb.m_size != monbox.size()) {
-    img.fb.release();
-    const uint32_t renderFormat = pickSafeRenderFormat(PMONITOR);
-    if (!img.fb.alloc(monbox.w, monbox.h, renderFormat)) {
-      Log::logger->log(Log::ERR,
-                       "[horza] captureWorkspace: fb.alloc failed idx={} size={}x{} fmt={}",
-                       idx, monbox.w, monbox.h, renderFormat);
-      blockDamageReporting = false;
+  if (!ensureCaptureFramebuffer(*img.fb, img.fbFormat, monbox, PMONITOR, false)) {
+    Log::logger->log(Log::ERR,
+                     "[horza] captureWorkspace: fb.alloc failed idx={} size={}x{} fmt={}",
+                     idx, monbox.w, monbox.h, pickCaptureFormat(PMONITOR, false));
+    blockDamageReporting = false;
+    return false;
+  }
+
+  renderWorkspaceSnapshot(PMONITOR, img.pWorkspace, *img.fb, monbox, false);
+
+  img.lastCaptureAt = std::chrono::steady_clock::now();
+  const float captureMs =
+      std::chrono::duration<float, std::milli>(img.lastCaptureAt - captureStartedAt)
+          .count();
+  frameWorkMs += captureMs;
+  g_horzaStats.workspaceCaptureMs.record(captureMs);
+  blockDamageReporting = false;
+  const auto tex = img.fb->getTexture();
+  const bool ok = isRenderableTexture(tex);
+  if (!ok) {
+    Log::logger->log(Log::ERR,
+                     "[horza] captureWorkspace: invalid texture idx={} ws={} fb={}x{} tex={}",
+                     idx, img.pWorkspace->m_id, img.fb->m_size.x, img.fb->m_size.y,
+                     tex ? (std::to_string((int)tex->m_size.x) + "x" +
+                            std::to_string((int)tex->m_size.y))
+                         : "null");
+    g_horzaStats.captureFailures++;
+  } else {
+    snapshotWindowBoxes(idx);
+    buildReducedLevel(idx, tex);
+  }
+  return ok;
+}
+
+// The presented buffer also carries what is composited over the workspace:
+// overlay layers, a software cursor, the screen shader and colour management.
+// Cards show none of these, so the buffer is only reused when none applies.
+static bool presentedFrameIsPlain(const PHLMONITOR& mon) {
+  static auto PSCREENSHADER = CConfigValue<std::string>("decoration:screen_shader");
+  if (!(*PSCREENSHADER).empty())
+    return false;
+  if (mon->m_cmType != NCMType::CM_SRGB || mon->m_sdrBrightness != 1.0f ||
+      mon->m_sdrSaturation != 1.0f)
+    return false;
+  if (g_pPointerManager->softwareLockedFor(mon) ||
+      g_pPointerManager->stateFor(mon)->hardwareFailed)
+    return false;
+
+  constexpr size_t LAYER_OVERLAY = 3;
+  for (const auto& ls : mon->m_layerSurfaceLayers[LAYER_OVERLAY]) {
+    const auto L = ls.lock();
+    if (L && L->m_mapped && !L->m_fadingOut)
       return false;
-    }
   }
+  return true;
+}
+
+bool COverview::captureFromPresentedFrame(int idx) {
+  if (!g_horzaConfig.reusePresentedFrame)
+    return false;
+  if (idx < 0 || idx >= (int)images.size())
+    return false;
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR || !PMONITOR->m_output || !PMONITOR->m_output->state)
+    return false;
+
+  // The frame on screen only matches the card when it shows exactly this
+  // workspace, unrotated.
+  auto& img = images[idx];
+  if (!img.pWorkspace || PMONITOR->m_activeWorkspace != img.pWorkspace ||
+      PMONITOR->m_activeSpecialWorkspace)
+    return false;
+  if (PMONITOR->m_transform != WL_OUTPUT_TRANSFORM_NORMAL ||
+      !presentedFrameIsPlain(PMONITOR))
+    return false;
+
+  const auto buffer = PMONITOR->m_output->state->state().buffer;
+  if (!buffer || buffer->size != PMONITOR->m_pixelSize)
+    return false;
 
+  CTraceSpan traceSpan("captureFromPresentedFrame", "idx", idx);
+  const auto captureStartedAt = std::chrono::steady_clock::now();
+
+  g_pHyprRenderer->makeEGLCurrent();
+  const auto presentedTex = makeShared<CTexture>(buffer);
+  if (!isRenderableTexture(presentedTex))
+    return false;
+
+  const float captureScale = clampCaptureScale(g_horzaConfig.captureScale);
+  const int captureW =
+      std::max(1, (int)std::round(PMONITOR->m_pixelSize.x * captureScale));
+  const int captureH =
+      std::max(1, (int)std::round(PMONITOR->m_pixelSize.y * captureScale));
+  CBox monbox = {0.0, 0.0, (double)captureW, (double)captureH};
+
+  if (!img.fb)
+    img.fb = makeShared<CFramebuffer>();
+  if (!ensureCaptureFramebuffer(*img.fb, img.fbFormat, monbox, PMONITOR, false))
+    return false;
+
+  blockDamageReporting = true;
   CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
   g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE,
-                               nullptr, &img.fb);
-
+                               nullptr, img.fb.get());
   g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
 
-  const bool oldBlockSurfaceFeedback = g_pHyprRenderer->m_bBlockSurfaceFeedback;
-  g_pHyprRenderer->m_bBlockSurfaceFeedback = true;
+  CHyprOpenGLImpl::STextureRenderData copyData;
+  copyData.damage = &fakeDamage;
+  copyData.a = 1.0f;
+  g_pHyprOpenGL->renderTextureInternal(presentedTex, monbox, copyData);
 
-  const auto oldActiveWorkspace = PMONITOR->m_activeWorkspace;
-  const auto oldActiveSpecialWorkspace = PMONITOR->m_activeSpecialWorkspace;
-  const bool targetIsOldActive = oldActiveWorkspace == img.pWorkspace;
+  g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+  g_pHyprRenderer->endRender();
+  blockDamageReporting = false;
 
-  const bool oldVisible = img.pWorkspace->m_visible;
-  const bool oldForceRendering = img.pWorkspace->m_forceRendering;
+  if (!isRenderableTexture(img.fb->getTexture()))
+    return false;
 
-  if (PMONITOR->m_activeSpecialWorkspace)
-    PMONITOR->m_activeSpecialWorkspace.reset();
-  if (oldActiveWorkspace && !targetIsOldActive)
-    oldActiveWorkspace->m_visible = false;
+  img.cachedTex.reset();
+  img.lastCaptureAt = std::chrono::steady_clock::now();
+  g_horzaStats.presentedFrameCaptures++;
+  frameWorkMs += std::chrono::duration<float, std::milli>(img.lastCaptureAt -
+                                                          captureStartedAt)
+                     .count();
+  snapshotWindowBoxes(idx);
+  buildReducedLevel(idx, img.fb->getTexture());
+  return true;
+}
 
-  PMONITOR->m_activeWorkspace = img.pWorkspace;
-  if (!targetIsOldActive) {
-    g_pDesktopAnimationManager->startAnimation(
-        img.pWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
+void COverview::buildReducedLevel(int idx, const SP<CTexture>& srcTex) {
+  if (idx < 0 || idx >= (int)images.size())
+    return;
+  auto& img = images[idx];
+  img.reducedValid = false;
+
+  if (!g_horzaConfig.downsampleCards) {
+    img.reducedFb.reset();
+    img.reducedFbFormat = 0;
+    return;
   }
-  img.pWorkspace->m_visible = true;
-  img.pWorkspace->m_forceRendering = true;
 
-  g_pHyprRenderer->renderWorkspace(PMONITOR, img.pWorkspace, Time::steadyNow(),
-                                   monbox);
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return;
+
+  if (!isRenderableTexture(srcTex))
+    return;
 
-  img.pWorkspace->m_forceRendering = oldForceRendering;
-  img.pWorkspace->m_visible = oldVisible;
-  if (!targetIsOldActive) {
-    g_pDesktopAnimationManager->startAnimation(
-        img.pWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+  // A single level sized for the centred card; drawing it is close to 1:1, so
+  // the per-frame sampling cost no longer scales with the capture resolution.
+  const float levelScale =
+      std::clamp(effectiveDisplayScale(g_horzaConfig.displayScale), 0.05f, 1.0f);
+  const int levelW =
+      std::max(1, (int)std::round(PMONITOR->m_pixelSize.x * levelScale));
+  const int levelH =
+      std::max(1, (int)std::round(PMONITOR->m_pixelSize.y * levelScale));
+  if (levelW >= srcTex->m_size.x * 0.9 && levelH >= srcTex->m_size.y * 0.9)
+    return;
+
+  CBox levelBox = {0.0, 0.0, (double)levelW, (double)levelH};
+
+  const bool oldBlockOverviewRendering = blockOverviewRendering;
+  blockOverviewRendering = true;
+  blockDamageReporting = true;
+  g_pHyprRenderer->makeEGLCurrent();
+
+  if (!img.reducedFb)
+    img.reducedFb = makeShared<CFramebuffer>();
+  if (!ensureCaptureFramebuffer(*img.reducedFb, img.reducedFbFormat, levelBox,
+                                PMONITOR, false)) {
+    blockDamageReporting = false;
+    blockOverviewRendering = oldBlockOverviewRendering;
+    return;
   }
 
-  PMONITOR->m_activeWorkspace = oldActiveWorkspace;
-  PMONITOR->m_activeSpecialWorkspace = oldActiveSpecialWorkspace;
-  if (oldActiveWorkspace && !targetIsOldActive)
-    oldActiveWorkspace->m_visible = true;
+  CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
+  g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE,
+                               nullptr, img.reducedFb.get());
+  g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
 
-  g_pHyprRenderer->m_bBlockSurfaceFeedback = oldBlockSurfaceFeedback;
+  CHyprOpenGLImpl::STextureRenderData levelData;
+  levelData.damage = &fakeDamage;
+  levelData.a = 1.0f;
+  g_pHyprOpenGL->renderTextureInternal(srcTex, levelBox, levelData);
 
   g_pHyprOpenGL->m_renderData.blockScreenShader = true;
   g_pHyprRenderer->endRender();
-
-  img.lastCaptureAt = std::chrono::steady_clock::now();
   blockDamageReporting = false;
-  const auto tex = img.fb.getTexture();
-  const bool ok = isRenderableTexture(tex);
-  if (!ok) {
-    Log::logger->log(Log::ERR,
-                     "[horza] captureWorkspace: invalid texture idx={} ws={} fb={}x{} tex={}",
-                     idx, img.pWorkspace->m_id, img.fb.m_size.x, img.fb.m_size.y,
-                     tex ? (std::to_string((int)tex->m_size.x) + "x" +
-                            std::to_string((int)tex->m_size.y))
-                         : "null");
-  }
-  return ok;
+  blockOverviewRendering = oldBlockOverviewRendering;
+
+  img.reducedValid = isRenderableTexture(img.reducedFb->getTexture());
+  if (img.reducedValid)
+    g_horzaStats.reducedLevelBuilds++;
+  img.reducedFromCaptureAt = img.lastCaptureAt;
 }
 
 void COverview::captureBackground() {
+  CTraceSpan traceSpan("captureBackground");
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
     return;
@@ -308,21 +714,24 @@ void COverview::captureBackground() {
 
   blockDamageReporting = true;
 
+  const auto captureStartedAt = std::chrono::steady_clock::now();
   CBox monbox = {0.0, 0.0, PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y};
 
   g_pHyprRenderer->makeEGLCurrent();
 
-  if (backgroundFb.m_size != monbox.size()) {
-    backgroundFb.release();
-    if (!backgroundFb.alloc(monbox.w, monbox.h, pickSafeRenderFormat(PMONITOR))) {
-      blockDamageReporting = false;
-      backgroundCaptured = false;
-      return;
-    }
+  if (!backgroundFb)
+    backgroundFb = makeShared<CFramebuffer>();
+  if (!ensureCaptureFramebuffer(*backgroundFb, backgroundFbFormat, monbox,
+                                PMONITOR, true)) {
+    blockDamageReporting = false;
+    backgroundCaptured = false;
+    return;
   }
 
   CFramebuffer rawBackgroundFb;
-  if (!rawBackgroundFb.alloc(monbox.w, monbox.h, pickSafeRenderFormat(PMONITOR))) {
+  uint32_t rawBackgroundFbFormat = 0;
+  if (!ensureCaptureFramebuffer(rawBackgroundFb, rawBackgroundFbFormat, monbox,
+                                PMONITOR, true)) {
     blockDamageReporting = false;
     backgroundCaptured = false;
     return;
@@ -356,7 +765,7 @@ void COverview::captureBackground() {
   g_pHyprRenderer->endRender();
 
   g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE,
-                               nullptr, &backgroundFb);
+                               nullptr, backgroundFb.get());
   g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
 
   CBox bgbox = {0, 0, PMONITOR->m_size.x, PMONITOR->m_size.y};
@@ -425,4 +834,58 @@ void COverview::captureBackground() {
 
   backgroundCaptured = true;
   blockDamageReporting = false;
+  g_horzaStats.backgroundCaptureMs.record(
+      std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() -
+                                               captureStartedAt)
+          .count());
+}
+
+// The blurred background of the last progressive open on each monitor, shown
+// until the next open has captured a fresh one.
+struct SRetainedBackground {
+  SP<CFramebuffer> fb;
+  uint32_t format = 0;
+  Vector2D pixelSize;
+};
+static std::unordered_map<int, SRetainedBackground> g_retainedBackgrounds;
+
+void COverview::retainBackground() {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return;
+  if (g_horzaConfig.openFirstFrameDeadlineMs <= 0.0f ||
+      !g_horzaConfig.hyprpaperBackground) {
+    g_retainedBackgrounds.clear();
+    return;
+  }
+  if (!backgroundCaptured || !backgroundFb ||
+      !isRenderableTexture(backgroundFb->getTexture()))
+    return;
+
+  auto& retained = g_retainedBackgrounds[PMONITOR->m_id];
+  retained.fb = std::move(backgroundFb);
+  retained.format = backgroundFbFormat;
+  retained.pixelSize = PMONITOR->m_pixelSize;
+  backgroundCaptured = false;
+}
+
+bool COverview::restoreRetainedBackground() {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return false;
+
+  const auto it = g_retainedBackgrounds.find(PMONITOR->m_id);
+  if (it == g_retainedBackgrounds.end())
+    return false;
+  if (it->second.pixelSize != PMONITOR->m_pixelSize ||
+      !it->second.fb || !isRenderableTexture(it->second.fb->getTexture())) {
+    g_retainedBackgrounds.erase(it);
+    return false;
+  }
+
+  backgroundFb = std::move(it->second.fb);
+  backgroundFbFormat = it->second.format;
+  backgroundCaptured = true;
+  g_retainedBackgrounds.erase(it);
+  return true;
 }
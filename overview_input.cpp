@@ -9,17 +9,13 @@
 #include <hyprland/src/desktop/state/FocusState.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/managers/KeybindManager.hpp>
+#include <hyprland/src/managers/SeatManager.hpp>
 #include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 
 int COverview::hitTileIndex(const Vector2D& localPos) const {
-  for (int i = 0; i < (int)images.size(); ++i) {
-    const auto& b = images[i].displayBox;
-    if (localPos.x >= b.x && localPos.x <= b.x + b.w && localPos.y >= b.y &&
-        localPos.y <= b.y + b.h)
-      return i;
-  }
-  return -1;
+  return hitStripCard(layout, (int)images.size(), localPos.x, localPos.y,
+                      [this](int i) -> const CBox& { return images[i].displayBox; });
 }
 
 Vector2D COverview::tileLocalToWorkspacePos(const CBox& tileBox,
@@ -38,25 +34,59 @@ Vector2D COverview::tileLocalToWorkspacePos(const CBox& tileBox,
   return {(localPos.x - tileBox.x) / scaleX, (localPos.y - tileBox.y) / scaleY};
 }
 
-PHLWINDOW COverview::pickWindowInWorkspace(const PHLWORKSPACE& ws,
-                                           const Vector2D& workspacePos) const {
+void COverview::snapshotWindowBoxes(int idx) {
+  if (idx < 0 || idx >= (int)images.size())
+    return;
+  auto& img = images[idx];
+  img.windowBoxes.clear();
+  img.windowBoxesValid = false;
+
   const auto PMONITOR = pMonitor.lock();
-  if (!PMONITOR || !ws)
-    return nullptr;
+  if (!PMONITOR || !img.pWorkspace)
+    return;
 
-  const Vector2D globalPos = workspacePos + PMONITOR->m_position;
   for (auto it = g_pCompositor->m_windows.rbegin();
        it != g_pCompositor->m_windows.rend(); ++it) {
     const auto& win = *it;
-    if (!win || !win->m_isMapped || win->m_workspace != ws)
+    if (!win || !win->m_isMapped || win->m_workspace != img.pWorkspace)
       continue;
 
-    const CBox winBox = win->getWindowBoxUnified(
+    CBox winBox = win->getWindowBoxUnified(
         Desktop::View::RESERVED_EXTENTS | Desktop::View::INPUT_EXTENTS |
         Desktop::View::ALLOW_FLOATING);
-    if (globalPos.x >= winBox.x && globalPos.x <= winBox.x + winBox.w &&
-        globalPos.y >= winBox.y && globalPos.y <= winBox.y + winBox.h)
-      return win;
+    winBox.x -= PMONITOR->m_position.x;
+    winBox.y -= PMONITOR->m_position.y;
+    img.windowBoxes.push_back({.window = win, .box = winBox});
+  }
+
+  img.windowBoxesValid = true;
+}
+
+PHLWINDOW COverview::pickWindowInWorkspace(int idx, const Vector2D& workspacePos,
+                                           CBox* outBox) {
+  if (idx < 0 || idx >= (int)images.size())
+    return nullptr;
+  if (!images[idx].windowBoxesValid)
+    snapshotWindowBoxes(idx);
+
+  const auto& img = images[idx];
+  if (!img.pWorkspace)
+    return nullptr;
+
+  for (const auto& hit : img.windowBoxes) {
+    const auto& b = hit.box;
+    if (workspacePos.x < b.x || workspacePos.x > b.x + b.w ||
+        workspacePos.y < b.y || workspacePos.y > b.y + b.h)
+      continue;
+
+    // Skip entries whose window left the workspace since the snapshot.
+    const auto win = hit.window.lock();
+    if (!win || !win->m_isMapped || win->m_workspace != img.pWorkspace)
+      continue;
+
+    if (outBox)
+      *outBox = b;
+    return win;
   }
 
   return nullptr;
@@ -117,14 +147,12 @@ bool COverview::shiftCurrentIndexBy(int step) {
   m_offsetX->setValueAndWarp(m_offsetX->value() + (oldCenter - newCenter));
   *m_offsetX = 0.0f;
 
-  if (!images[currentIdx].captured && !images[currentIdx].cachedTex) {
-    blockOverviewRendering = true;
-    images[currentIdx].captured = captureWorkspace(currentIdx);
-    blockOverviewRendering = false;
-    images[currentIdx].cachedTex.reset();
-  } else if (!images[currentIdx].captured && images[currentIdx].cachedTex) {
+  // Never capture here: onPreRender captures the new centre card once the
+  // selection settles.
+  if (!images[currentIdx].captured && !images[currentIdx].cachedTex)
+    settleCapturePending = true;
+  else if (!images[currentIdx].captured && images[currentIdx].cachedTex)
     damageDirty = true;
-  }
 
   pendingCapture = true;
   damage();
@@ -132,6 +160,26 @@ bool COverview::shiftCurrentIndexBy(int step) {
 }
 
 void COverview::onMouseMove() {
+  // Only a held button makes motion matter; button handlers read the
+  // position themselves.
+  if (closing || !leftButtonDown)
+    return;
+  if (pointerMotionPending)
+    return;
+
+  // Hover and drop-target work runs once per frame from onPreRender with
+  // the latest pointer position.
+  pointerMotionPending = true;
+  pointerMotionAt = std::chrono::steady_clock::now();
+  damage();
+}
+
+void COverview::applyPointerMotion() {
+  if (!pointerMotionPending)
+    return;
+  pointerMotionPending = false;
+  const auto inputAt = pointerMotionAt;
+
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
     return;
@@ -159,6 +207,7 @@ void COverview::onMouseMove() {
     const bool canJump = dragNextHoverJumpAt.time_since_epoch().count() == 0 ||
                          now >= dragNextHoverJumpAt;
     if (canJump && shiftCurrentIndexBy(newTargetIdx - currentIdx)) {
+      notePendingInput(INPUT_LATENCY_DRAG_HOVER, inputAt);
       const float delayMs = std::max(0.0f, g_horzaConfig.dragHoverJumpDelayMs);
       const auto cooldown = std::chrono::milliseconds((int)std::lround(delayMs));
       dragNextHoverJumpAt = now + cooldown;
@@ -168,6 +217,7 @@ void COverview::onMouseMove() {
   newTargetIdx = hitTileIndex(lastMousePosLocal);
   if (newTargetIdx != dragTargetIdx) {
     dragTargetIdx = newTargetIdx;
+    notePendingInput(INPUT_LATENCY_DRAG_HOVER, inputAt);
     damage();
   }
 }
@@ -177,6 +227,8 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
     return;
+  // Motion since the last frame decides the drag before the button does.
+  applyPointerMotion();
   lastMousePosLocal =
       g_pInputManager->getMouseCoordsInternal() - PMONITOR->m_position;
 
@@ -196,27 +248,29 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
       const auto PHITWS = images[dragSourceIdx].pWorkspace;
       const Vector2D workspacePos =
           tileLocalToWorkspacePos(hitBox, lastMousePosLocal);
-      dragWindow = pickWindowInWorkspace(PHITWS, workspacePos);
+      CBox winBoxLocal;
+      dragWindow = pickWindowInWorkspace(dragSourceIdx, workspacePos, &winBoxLocal);
       if (!dragWindow && PHITWS) {
         dragWindow = PHITWS->getLastFocusedWindow();
         if (!dragWindow)
           dragWindow = PHITWS->getFirstWindow();
         if (dragWindow && dragWindow->m_workspace != PHITWS)
           dragWindow.reset();
+        if (dragWindow) {
+          winBoxLocal = dragWindow->getWindowBoxUnified(
+              Desktop::View::RESERVED_EXTENTS | Desktop::View::INPUT_EXTENTS |
+              Desktop::View::ALLOW_FLOATING);
+          winBoxLocal.x -= PMONITOR->m_position.x;
+          winBoxLocal.y -= PMONITOR->m_position.y;
+        }
       }
 
       if (dragWindow) {
-        const CBox winBox = dragWindow->getWindowBoxUnified(
-            Desktop::View::RESERVED_EXTENTS | Desktop::View::INPUT_EXTENTS |
-            Desktop::View::ALLOW_FLOATING);
         dragWindowSizeWorkspace = {
-            std::max(1.0, winBox.w),
-            std::max(1.0, winBox.h),
-        };
-        const Vector2D winTopLeftLocal = {
-            winBox.x - PMONITOR->m_position.x,
-            winBox.y - PMONITOR->m_position.y,
+            std::max(1.0, winBoxLocal.w),
+            std::max(1.0, winBoxLocal.h),
         };
+        const Vector2D winTopLeftLocal = {winBoxLocal.x, winBoxLocal.y};
         dragWindowPosWorkspace = winTopLeftLocal;
         const Vector2D grabOffset = workspacePos - winTopLeftLocal;
         dragWindowGrabOffsetWorkspace = {
@@ -258,6 +312,8 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
       images[sourceIdx].titleMaxWidthCached = 0;
       images[sourceIdx].titleFontCached = 0;
       images[sourceIdx].titleFontFamilyCached.clear();
+      images[sourceIdx].windowBoxes.clear();
+      images[sourceIdx].windowBoxesValid = false;
     }
     if (targetIdx >= 0 && targetIdx < (int)images.size()) {
       images[targetIdx].captured = false;
@@ -267,6 +323,8 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
       images[targetIdx].titleMaxWidthCached = 0;
       images[targetIdx].titleFontCached = 0;
       images[targetIdx].titleFontFamilyCached.clear();
+      images[targetIdx].windowBoxes.clear();
+      images[targetIdx].windowBoxesValid = false;
     }
 
     workspaceListDirty = true;
@@ -294,7 +352,7 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
   if (PMONITOR->m_activeWorkspace != PHITWS)
     g_pKeybindManager->m_dispatchers.at("workspace")(std::to_string(PHITWS->m_id));
 
-  const auto PWINDOW = pickWindowInWorkspace(PHITWS, workspacePos);
+  const auto PWINDOW = pickWindowInWorkspace(hitIdx, workspacePos);
 
   if (PWINDOW)
     Desktop::focusState()->fullWindowFocus(PWINDOW, Desktop::FOCUS_REASON_CLICK);
@@ -304,6 +362,7 @@ void COverview::onMouseButton(const IPointer::SButtonEvent& e,
 
 void COverview::onMouseAxis(const IPointer::SAxisEvent& e,
                             SCallbackInfo& info) {
+  const auto inputAt = std::chrono::steady_clock::now();
   if (closing || images.size() < 2)
     return;
 
@@ -319,6 +378,16 @@ void COverview::onMouseAxis(const IPointer::SAxisEvent& e,
 
   info.cancelled = true;
 
+  if (g_horzaConfig.touchpadFollow && e.source == WL_POINTER_AXIS_SOURCE_FINGER) {
+    // libinput ends a finger scroll with a zero-delta axis event.
+    if (e.delta == 0.0)
+      settleTouchpadGesture();
+    else
+      followTouchpadGesture(e.delta, inputAt);
+    notePendingInput(INPUT_LATENCY_SCROLL, inputAt);
+    return;
+  }
+
   int steps = 0;
   const double discrete =
       e.deltaDiscrete != 0.0 ? (double)e.deltaDiscrete : 0.0;
@@ -341,69 +410,216 @@ void COverview::onMouseAxis(const IPointer::SAxisEvent& e,
   if (steps == 0)
     return;
 
-  const int targetIdx =
-      std::clamp(currentIdx + steps, 0, (int)images.size() - 1);
-  if (targetIdx == currentIdx)
-    return;
+  // Steps are applied once per frame in onPreRender; a flick across several
+  // cards then moves the strip once and captures only where it stops.
+  const bool hadStep = lastScrollStepAt.time_since_epoch().count() != 0;
+  scrollAtSpeed = hadStep && inputAt - lastScrollStepAt < std::chrono::milliseconds(120);
+  lastScrollStepAt = inputAt;
+  pendingScrollSteps += steps;
+  notePendingInput(INPUT_LATENCY_SCROLL, inputAt);
+  damage();
+}
 
-  if (!m_scale || !m_offsetX)
-    return;
+float COverview::stripPitch() const {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR || !m_scale)
+    return 0.0f;
 
   const float targetDisplayScale = effectiveDisplayScale(g_horzaConfig.displayScale);
   const float sMin = std::min(1.0f, targetDisplayScale);
   const float sMax = std::max(1.0f, targetDisplayScale);
-  float s = std::clamp(m_scale->value(), sMin, sMax);
-  float ds = std::max(targetDisplayScale, 0.0001f);
-  float tileW = PMONITOR->m_size.x * s;
-  float tileH = PMONITOR->m_size.y * s;
-  float baseGap = g_horzaConfig.overviewGap;
-  float gap = baseGap * (s / ds);
-  bool vertical = g_horzaConfig.vertical;
+  const float s = std::clamp(m_scale->value(), sMin, sMax);
+  const float ds = std::max(targetDisplayScale, 0.0001f);
+  const float tile = g_horzaConfig.vertical ? PMONITOR->m_size.y * s : PMONITOR->m_size.x * s;
+  return tile + g_horzaConfig.overviewGap * (s / ds);
+}
 
-  const float oldCenter = !vertical
-                              ? PMONITOR->m_size.x * 0.5f -
-                                    (currentIdx * (tileW + gap) + tileW * 0.5f)
-                              : PMONITOR->m_size.y * 0.5f -
-                                    (currentIdx * (tileH + gap) + tileH * 0.5f);
-  const float newCenter = !vertical
-                              ? PMONITOR->m_size.x * 0.5f -
-                                    (targetIdx * (tileW + gap) + tileW * 0.5f)
-                              : PMONITOR->m_size.y * 0.5f -
-                                    (targetIdx * (tileH + gap) + tileH * 0.5f);
+void COverview::followTouchpadGesture(double delta,
+                                      std::chrono::steady_clock::time_point at) {
+  const float pitch = stripPitch();
+  if (pitch <= 0.0f || !m_offsetX)
+    return;
 
+  // Scrolling forward moves the strip back, like the stepped path.
+  const float move = -(float)delta;
+  const float dtMs =
+      std::chrono::duration<float, std::milli>(at - touchpadGestureLastAt).count();
+  if (!touchpadGestureActive || dtMs > 50.0f) {
+    touchpadGestureActive = true;
+    touchpadGestureVelocity = 0.0f;
+  } else {
+    touchpadGestureVelocity =
+        touchpadGestureVelocity * 0.6f + move / std::max(1.0f, dtMs) * 0.4f;
+  }
+  touchpadGestureLastAt = at;
+
+  // Keep the card nearest the centre as currentIdx so its neighbours stay in
+  // the render radius; the offset absorbs the re-centre so nothing jumps.
+  float offset = m_offsetX->value() + move;
+  const int lastIdx = (int)images.size() - 1;
+  while (offset > pitch * 0.5f && currentIdx > 0) {
+    currentIdx--;
+    offset -= pitch;
+  }
+  while (offset < -pitch * 0.5f && currentIdx < lastIdx) {
+    currentIdx++;
+    offset += pitch;
+  }
+  const float overscroll = pitch * 0.25f;
+  if (currentIdx == 0)
+    offset = std::min(offset, overscroll);
+  if (currentIdx == lastIdx)
+    offset = std::max(offset, -overscroll);
+
+  m_offsetX->setValueAndWarp(offset);
+  lastSelectionChangeAt = at;
+  damage();
+}
+
+void COverview::settleTouchpadGesture() {
+  if (!touchpadGestureActive)
+    return;
+  touchpadGestureActive = false;
+
+  const float pitch = stripPitch();
+  if (pitch <= 0.0f || !m_offsetX)
+    return;
+
+  // Project the release velocity a little ahead; a quick flick that would
+  // land back on the same card still moves one card in its direction.
+  constexpr float kFlickProjectionMs = 120.0f;
+  constexpr float kFlickVelocity = 0.4f;
+  const float velocity = touchpadGestureVelocity;
+  float offset = m_offsetX->value();
+  int step = (int)std::lround(-(offset + velocity * kFlickProjectionMs) / pitch);
+  if (step == 0 && std::abs(velocity) >= kFlickVelocity)
+    step = velocity < 0.0f ? 1 : -1;
+  step = std::clamp(step, -1, 1);
+
+  const int targetIdx = std::clamp(currentIdx + step, 0, (int)images.size() - 1);
+  offset += (float)(targetIdx - currentIdx) * pitch;
   currentIdx = targetIdx;
-  lastSelectionChangeAt = std::chrono::steady_clock::now();
+  g_horzaTracer.instant("touchpadSettle", "idx", currentIdx);
 
-  m_offsetX->setValueAndWarp(m_offsetX->value() + (oldCenter - newCenter));
+  m_offsetX->setValueAndWarp(offset);
   *m_offsetX = 0.0f;
+  lastSelectionChangeAt = std::chrono::steady_clock::now();
 
-  if (!images[currentIdx].captured && !images[currentIdx].cachedTex) {
-    blockOverviewRendering = true;
-    images[currentIdx].captured = captureWorkspace(currentIdx);
-    blockOverviewRendering = false;
-    images[currentIdx].cachedTex.reset();
-  } else if (!images[currentIdx].captured && images[currentIdx].cachedTex) {
-    damageDirty = true;
-  }
-
+  // The landing card is captured by the optional capture pass once the snap
+  // animation ends; until then it shows its cached texture or placeholder.
   pendingCapture = true;
   damage();
 }
 
 void COverview::onKeyPress(const IKeyboard::SKeyEvent& e,
                            SCallbackInfo& info) {
+  const bool pressed = e.state == WL_KEYBOARD_KEY_STATE_PRESSED;
+  if (!pressed) {
+    // Swallow releases of keys we consumed so clients never see half a press,
+    // also once closing or with a modifier pressed since.
+    if (handledNavigationKeys.erase(e.keycode))
+      info.cancelled = true;
+    return;
+  }
+
   if (closing)
     return;
-  if (!g_horzaConfig.escOnly)
+
+  if (e.keycode == KEY_ESC) {
+    if (!g_horzaConfig.escOnly)
+      return;
+    info.cancelled = true;
+    handledNavigationKeys.insert(e.keycode);
+    close();
+    return;
+  }
+
+  // Modified keys stay with the user's binds.
+  if (transitMode || !g_horzaConfig.keyboardNavigation ||
+      g_pInputManager->getModsFromAllKBs() != 0)
     return;
 
-  if (e.keycode != KEY_ESC)
+  // Keys are matched by keysym in the active layout, like Hyprland binds.
+  const auto keyboard = g_pSeatManager->m_keyboard.lock();
+  if (!keyboard || !keyboard->m_xkbState)
+    return;
+  const xkb_keysym_t keysym = xkb_keysym_to_lower(
+      xkb_state_key_get_one_sym(keyboard->m_xkbState, e.keycode + 8));
+
+  const auto inputAt = std::chrono::steady_clock::now();
+  if (!handleNavigationKey(keysym))
     return;
 
   info.cancelled = true;
+  handledNavigationKeys.insert(e.keycode);
+  notePendingInput(INPUT_LATENCY_KEY, inputAt);
+}
 
-  if (e.state == WL_KEYBOARD_KEY_STATE_PRESSED)
+bool COverview::handleNavigationKey(xkb_keysym_t keysym) {
+  if (images.empty())
+    return false;
+
+  int targetIdx = -1;
+  switch (keysym) {
+  case XKB_KEY_Left:
+  case XKB_KEY_Up:
+  case XKB_KEY_h:
+  case XKB_KEY_k:
+    targetIdx = currentIdx - 1;
+    break;
+  case XKB_KEY_Right:
+  case XKB_KEY_Down:
+  case XKB_KEY_l:
+  case XKB_KEY_j:
+    targetIdx = currentIdx + 1;
+    break;
+  case XKB_KEY_Home:
+    targetIdx = 0;
+    break;
+  case XKB_KEY_End:
+    targetIdx = (int)images.size() - 1;
+    break;
+  case XKB_KEY_Return:
+  case XKB_KEY_KP_Enter:
+  case XKB_KEY_space:
+    commitSelection();
+    return true;
+  default:
+    // 1..9 and 0 select workspaces 1..10 by ID, like the default binds.
+    if (keysym >= XKB_KEY_0 && keysym <= XKB_KEY_9) {
+      const int64_t workspaceID = keysym == XKB_KEY_0 ? 10 : (int64_t)(keysym - XKB_KEY_0);
+      targetIdx = findWorkspaceCardByID(workspaceID);
+      if (targetIdx < 0)
+        return true;
+      break;
+    }
+    return false;
+  }
+
+  // The strip moves now; a card without a texture goes to the front of the
+  // capture queue, which the optional capture pass drains within the frame
+  // budget, instead of the synchronous settle capture scrolling uses.
+  targetIdx = std::clamp(targetIdx, 0, (int)images.size() - 1);
+  scrollAtSpeed = false;
+  shiftCurrentIndexBy(targetIdx - currentIdx);
+  if (settleCapturePending) {
+    settleCapturePending = false;
+    queueWorkspaceCapture(currentIdx, true);
+  }
+  return true;
+}
+
+void COverview::commitSelection() {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR || currentIdx < 0 || currentIdx >= (int)images.size()) {
     close();
+    return;
+  }
+
+  const auto PWS = images[currentIdx].pWorkspace;
+  if (PWS && PMONITOR->m_activeWorkspace != PWS)
+    g_pKeybindManager->m_dispatchers.at("workspace")(std::to_string(PWS->m_id));
+  close();
 }
 
 void COverview::onWorkspaceChange() {
@@ -452,10 +668,10 @@ void COverview::onWorkspaceChange() {
 
   if (transitMode) {
     m_offsetX->setCallbackOnEnd(
-        [](WP<Hyprutils::Animation::CBaseAnimatedVariable> var) {
-          g_pEventLoopManager->doLater([]() {
-            if (g_pOverview && g_pOverview->transitMode)
-              g_pOverview->close();
+        [this](WP<Hyprutils::Animation::CBaseAnimatedVariable> var) {
+          g_pEventLoopManager->doLater([self = this]() {
+            if (overviewAlive(self) && self->transitMode)
+              self->close();
           });
         });
   }
@@ -474,7 +690,13 @@ void COverview::onWorkspaceChange() {
 }
 
 void COverview::requestWorkspaceSync() {
+  g_horzaStats.workspaceSyncEvents++;
+  markWorkspaceListDirty();
+}
+
+void COverview::markWorkspaceListDirty() {
   workspaceListDirty = true;
+  frozenAnimVarsDirty = true;
   nextWorkspaceSyncPollAt = std::chrono::steady_clock::now();
   damageRefreshIdx = -1;
   pendingCapture = true;
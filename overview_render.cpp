@@ -19,6 +19,7 @@
 #include <hyprland/src/Compositor.hpp>
 #include <hyprland/src/debug/log/Logger.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/managers/animation/AnimationManager.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/render/Renderer.hpp>
 #undef private
@@ -160,6 +161,8 @@ bool COverview::shouldDeferCaptures() const {
   if (closing)
     return false;
   if (openingAnimInProgress())
+    return !progressiveOpen;
+  if (touchpadGestureActive)
     return true;
   if (switchAnimInProgress())
     return true;
@@ -177,9 +180,12 @@ bool COverview::needsFramePump() const {
     return true;
   if (m_crossOffset && m_crossOffset->isBeingAnimated())
     return true;
-  if (leftButtonDown || draggingWindow)
+  if (leftButtonDown || draggingWindow || touchpadGestureActive)
     return true;
-  if (pendingCapture || damageDirty)
+  if (pendingScrollSteps != 0 || settleCapturePending)
+    return true;
+  if (pendingCapture || damageDirty || backgroundRefreshPending ||
+      !captureQueue.empty())
     return true;
   return false;
 }
@@ -187,6 +193,9 @@ bool COverview::needsFramePump() const {
 bool COverview::framePumpDue(std::chrono::steady_clock::time_point now) const {
   float fps = clampFramePumpFps(g_horzaConfig.framePumpFps);
   if (fps <= 0.0f) {
+    // Presentation feedback already paces us to the monitor's vblank.
+    if (presentHook.has_value())
+      return true;
     if (const auto PMONITOR = pMonitor.lock())
       fps = std::clamp(PMONITOR->m_refreshRate, 30.0f, 240.0f);
     else
@@ -208,13 +217,146 @@ void COverview::pumpFrameIfDue(bool force) {
   }
 
   const auto now = std::chrono::steady_clock::now();
+
+  // Keep at most one pumped frame in flight; the next one is requested from
+  // the present event. A commit that never presents (e.g. nothing changed on
+  // screen) would stall the pump, so give up on it after a few refreshes.
+  if (framePumpArmed && presentHook.has_value()) {
+    float refreshHz = 60.0f;
+    if (const auto PMONITOR = pMonitor.lock())
+      refreshHz = std::clamp(PMONITOR->m_refreshRate, 30.0f, 240.0f);
+    const auto staleAfter = std::chrono::duration<double>(3.0 / refreshHz);
+    if (now - lastFramePumpAt < staleAfter)
+      return;
+  }
+
   if (!force && !framePumpDue(now))
     return;
 
   lastFramePumpAt = now;
+  framePumpArmed = true;
+  framesScheduled++;
+  g_horzaStats.framesPumped++;
+  g_horzaTracer.instant("framePump", "forced", force);
   damage();
 }
 
+void COverview::listenForPresentation() {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR || !PMONITOR->m_output)
+    return;
+
+  presentHook = PMONITOR->m_output->events.present.listen(
+      [this](const Aquamarine::IOutput::SPresentEvent& e) {
+        onOutputPresented(e.presented);
+      });
+}
+
+void COverview::onOutputPresented(bool presented) {
+  g_horzaTracer.instant("present", "presented", presented);
+  if (presented) {
+    framesPresented++;
+    g_horzaStats.framesPresented++;
+  }
+  framePumpArmed = false;
+  lastPresentedAt = std::chrono::steady_clock::now();
+
+  if (blockOverviewRendering || closeDropScheduled)
+    return;
+  if (needsFramePump())
+    pumpFrameIfDue();
+  if (!closing)
+    scheduleIdleCaptureSlot();
+}
+
+float COverview::livePreviewFpsNow() const {
+  const float configured = std::max(0.0f, g_horzaConfig.livePreviewFps);
+  if (!g_horzaConfig.adaptiveLivePreview || governedPreviewFps < 0.0f)
+    return configured;
+  const float lo = std::min(configured, std::max(0.0f, g_horzaConfig.livePreviewFpsMin));
+  return std::clamp(governedPreviewFps, lo, configured);
+}
+
+int COverview::capturesPerFrameNow() const {
+  const int configured = std::max(0, g_horzaConfig.maxCapturesPerFrame);
+  if (!g_horzaConfig.adaptiveLivePreview || governedCapturesPerFrame < 0 ||
+      configured == 0)
+    return configured;
+  const int hi = std::max(configured, g_horzaConfig.adaptiveMaxCapturesPerFrame);
+  return std::clamp(governedCapturesPerFrame, std::min(1, hi), hi);
+}
+
+void COverview::updatePreviewGovernor() {
+  const float sampleMs = frameWorkMs;
+  frameWorkMs = 0.0f;
+
+  if (governedPreviewFps < 0.0f || governedCapturesPerFrame < 0) {
+    governedPreviewFps = std::max(0.0f, g_horzaConfig.livePreviewFps);
+    governedCapturesPerFrame = std::max(0, g_horzaConfig.maxCapturesPerFrame);
+  }
+
+  // Frame work = our render pass plus any captures since the last frame.
+  frameWorkEmaMs =
+      frameWorkEmaMs < 0.0f ? sampleMs : frameWorkEmaMs * 0.8f + sampleMs * 0.2f;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (governorNextStepAt.time_since_epoch().count() != 0 && now < governorNextStepAt)
+    return;
+  governorNextStepAt = now + std::chrono::milliseconds(250);
+
+  float refreshHz = 60.0f;
+  if (const auto PMONITOR = pMonitor.lock())
+    refreshHz = std::clamp(PMONITOR->m_refreshRate, 30.0f, 240.0f);
+  const float intervalMs = 1000.0f / refreshHz;
+
+  const float oldFps = livePreviewFpsNow();
+  const int oldCaptures = capturesPerFrameNow();
+  float fps = oldFps;
+  int captures = oldCaptures;
+
+  if (frameWorkEmaMs > intervalMs * 0.85f) {
+    fps *= 0.7f;
+    captures -= 1;
+  } else if (frameWorkEmaMs < intervalMs * 0.5f) {
+    fps = std::max(fps * 1.15f, fps + 1.0f);
+    captures += 1;
+  }
+
+  governedPreviewFps = fps;
+  governedCapturesPerFrame = captures;
+
+  const float newFps = livePreviewFpsNow();
+  const int newCaptures = capturesPerFrameNow();
+  governedPreviewFps = newFps;
+  governedCapturesPerFrame = newCaptures;
+  if (std::fabs(newFps - oldFps) >= 0.5f || newCaptures != oldCaptures) {
+    g_horzaTracer.instant("governorStep", "live_preview_fps", (int64_t)newFps);
+    Log::logger->log(Log::DEBUG,
+                     "[horza] governor: frame work {:.2f}ms of {:.2f}ms -> "
+                     "live_preview_fps {:.1f}, captures/frame {}",
+                     frameWorkEmaMs, intervalMs, newFps, newCaptures);
+  }
+}
+
+void COverview::notePendingInput(eInputLatencyKind kind,
+                                 std::chrono::steady_clock::time_point at) {
+  if (kind >= INPUT_LATENCY_KIND_COUNT)
+    return;
+  if (pendingInputAt[kind].time_since_epoch().count() == 0)
+    pendingInputAt[kind] = at;
+}
+
+void COverview::flushInputLatency() {
+  const auto now = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < pendingInputAt.size(); ++i) {
+    if (pendingInputAt[i].time_since_epoch().count() == 0)
+      continue;
+    g_horzaStats.inputLatency[i].record(
+        std::chrono::duration<float, std::milli>(now - pendingInputAt[i]).count());
+    pendingInputAt[i] = {};
+  }
+}
+
 bool COverview::closeDropPending() const { return closeDropScheduled; }
 
 void COverview::scheduleCloseDrop() {
@@ -304,44 +446,23 @@ bool COverview::isTileOnScreen(const CBox& box) const {
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
     return false;
-  if (box.w <= 1.0 || box.h <= 1.0)
-    return false;
+  return cardRectOnScreen({box.x, box.y, box.w, box.h}, PMONITOR->m_size.x,
+                          PMONITOR->m_size.y);
+}
 
-  return box.x + box.w > 0.0 && box.y + box.h > 0.0 &&
-         box.x < PMONITOR->m_size.x && box.y < PMONITOR->m_size.y;
+SCardCaptureState COverview::captureStateOf(int idx) const {
+  const auto& img = images[idx];
+  return {.captured = img.captured,
+          .onScreen = isTileOnScreen(img.displayBox),
+          .lastCaptureAt = img.lastCaptureAt};
 }
 
 int COverview::pickVisibleLivePreviewWorkspace(
     std::chrono::steady_clock::time_point now) const {
-  if (images.size() < 2)
-    return -1;
-
-  const float fps = std::clamp(g_horzaConfig.livePreviewFps, 0.0f, 60.0f);
-  if (fps <= 0.0f)
-    return -1;
-  const auto minVisibleInterval = std::chrono::duration<float>(1.0f / fps);
-  const int captureRadius = std::max(0, g_horzaConfig.livePreviewRadius);
-
-  int bestIdx = -1;
-  auto bestCaptureTime = std::chrono::steady_clock::time_point::max();
-
-  for (int i = 0; i < (int)images.size(); ++i) {
-    if (i == currentIdx || !images[i].captured)
-      continue;
-    if (captureRadius <= 0 || std::abs(i - currentIdx) > captureRadius)
-      continue;
-    if (!isTileOnScreen(images[i].displayBox))
-      continue;
-    if (now - images[i].lastCaptureAt < minVisibleInterval)
-      continue;
-
-    if (bestIdx == -1 || images[i].lastCaptureAt < bestCaptureTime) {
-      bestIdx = i;
-      bestCaptureTime = images[i].lastCaptureAt;
-    }
-  }
-
-  return bestIdx;
+  return pickLivePreviewCard((int)images.size(), currentIdx,
+                             std::max(0, g_horzaConfig.livePreviewRadius),
+                             livePreviewFpsNow(), now,
+                             [this](int i) { return captureStateOf(i); });
 }
 
 std::string COverview::workspaceTitleFor(const PHLWORKSPACE& ws) const {
@@ -369,24 +490,57 @@ std::string COverview::workspaceTitleFor(const PHLWORKSPACE& ws) const {
   return title;
 }
 
-void COverview::suppressGlobalAnimations() const {
+void COverview::suppressGlobalAnimations() {
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
     return;
 
-  
+  if (frozenAnimVarsDirty) {
+    freezeMonitorAnimations();
+    return;
+  }
+
+  // Steady state: only variables that started animating since the last
+  // frame, so the cost does not grow with the number of windows.
+  frozenAnimStarted.clear();
+  for (const auto& weak : g_pAnimationManager->m_vActiveAnimatedVariables) {
+    const auto var = weak.lock();
+    if (!var || !var->isBeingAnimated())
+      continue;
+    const auto it = frozenAnimVars.find(var.get());
+    if (it != frozenAnimVars.end() && it->second.lock() == var)
+      frozenAnimStarted.push_back(var);
+  }
+  for (const auto& var : frozenAnimStarted)
+    var->warp();
+  frozenAnimStarted.clear();
+}
+
+void COverview::freezeMonitorAnimations() {
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return;
+
+  frozenAnimVars.clear();
+  frozenAnimVarsDirty = false;
+
+  const auto freeze = [this](const auto& var, bool warpNow = true) {
+    if (!var)
+      return;
+    if (warpNow)
+      var->setValueAndWarp(var->goal());
+    frozenAnimVars[var.get()] = var;
+  };
+
   for (const auto& wsWeak : g_pCompositor->m_workspaces) {
     const auto ws = wsWeak.lock();
     if (!ws || ws->monitorID() != PMONITOR->m_id)
       continue;
 
-    if (ws->m_renderOffset)
-      ws->m_renderOffset->setValueAndWarp(ws->m_renderOffset->goal());
-    if (ws->m_alpha)
-      ws->m_alpha->setValueAndWarp(ws->m_alpha->goal());
+    freeze(ws->m_renderOffset);
+    freeze(ws->m_alpha);
   }
 
-  
   for (const auto& win : g_pCompositor->m_windows) {
     if (!win)
       continue;
@@ -398,28 +552,18 @@ void COverview::suppressGlobalAnimations() const {
       onOverviewMonitor = true;
     if (!onOverviewMonitor)
       continue;
-    if (!win->m_isMapped && !win->m_fadingOut)
-      continue;
 
-    if (win->m_realPosition)
-      win->m_realPosition->setValueAndWarp(win->m_realPosition->goal());
-    if (win->m_realSize)
-      win->m_realSize->setValueAndWarp(win->m_realSize->goal());
-    if (win->m_alpha)
-      win->m_alpha->setValueAndWarp(win->m_alpha->goal());
-    if (win->m_activeInactiveAlpha)
-      win->m_activeInactiveAlpha->setValueAndWarp(win->m_activeInactiveAlpha->goal());
-    if (win->m_movingFromWorkspaceAlpha)
-      win->m_movingFromWorkspaceAlpha->setValueAndWarp(
-          win->m_movingFromWorkspaceAlpha->goal());
-    if (win->m_movingToWorkspaceAlpha)
-      win->m_movingToWorkspaceAlpha->setValueAndWarp(
-          win->m_movingToWorkspaceAlpha->goal());
+    // Unmapped windows are tracked too, so they freeze once they map.
+    const bool warpNow = win->m_isMapped || win->m_fadingOut;
+    freeze(win->m_realPosition, warpNow);
+    freeze(win->m_realSize, warpNow);
+    freeze(win->m_alpha, warpNow);
+    freeze(win->m_activeInactiveAlpha, warpNow);
+    freeze(win->m_movingFromWorkspaceAlpha, warpNow);
+    freeze(win->m_movingToWorkspaceAlpha, warpNow);
   }
 
-  
-  if (PMONITOR->m_specialFade)
-    PMONITOR->m_specialFade->setValueAndWarp(PMONITOR->m_specialFade->goal());
+  freeze(PMONITOR->m_specialFade);
 }
 
 void COverview::suppressWorkspaceWindowAnimations(const PHLWORKSPACE& ws) const {
@@ -450,6 +594,7 @@ void COverview::suppressWorkspaceWindowAnimations(const PHLWORKSPACE& ws) const
 }
 
 void COverview::renderWorkspaceTitle(int idx, const CRegion& dmg, float tileScale) {
+  CTraceSpan traceSpan("renderWorkspaceTitle", "idx", idx);
   (void)tileScale;
 
   if (idx < 0 || idx >= (int)images.size())
@@ -558,10 +703,14 @@ void COverview::renderWorkspaceTitle(int idx, const CRegion& dmg, float tileScal
 
 
 void COverview::fullRender() {
+  CTraceSpan traceSpan("fullRender");
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR || images.empty())
     return;
 
+  const auto renderStartedAt = std::chrono::steady_clock::now();
+  g_horzaStats.framesRendered++;
+
   if (openAnimPending && !closing) {
     openAnimPending = false;
     *m_scale = effectiveDisplayScale(g_horzaConfig.displayScale);
@@ -580,39 +729,22 @@ void COverview::fullRender() {
       transitMode ? 1.0f : std::clamp(m_scale ? m_scale->value() : 1.0f, sMin, sMax);
   if (!std::isfinite(s))
     s = transitMode ? 1.0f : targetDisplayScale;
-  float tileW = PMONITOR->m_size.x * s;
-  float tileH = PMONITOR->m_size.y * s;
-  float baseGap = g_horzaConfig.overviewGap;
-  float gap = transitMode ? 0.0f : baseGap * (s / ds);
-  bool vertical = transitMode ? false : g_horzaConfig.vertical;
-  const float centerOffset =
-      transitMode
-          ? 0.0f
-          : (m_crossOffset ? m_crossOffset->value() : g_horzaConfig.centerOffset);
-
-  float startX = 0.0f;
-  float startY = 0.0f;
-
-  if (!vertical) {
-    float centerX = PMONITOR->m_size.x * 0.5f -
-                    (currentIdx * (tileW + gap) + tileW * 0.5f);
-    startX = centerX + (m_offsetX ? m_offsetX->value() : 0.0f);
-    startY = (PMONITOR->m_size.y - tileH) * 0.5f + centerOffset;
-  } else {
-    float centerY = PMONITOR->m_size.y * 0.5f -
-                    (currentIdx * (tileH + gap) + tileH * 0.5f);
-    startY = centerY + (m_offsetX ? m_offsetX->value() : 0.0f);
-    startX = (PMONITOR->m_size.x - tileW) * 0.5f + centerOffset;
-  }
-
-  const float inactiveTileSizeScale = transitMode
-                                          ? 1.0f
-                                          : std::clamp(
-                                                g_horzaConfig.inactiveTileSizePercent * 0.01f,
-                                                0.0f, 1.0f);
-  const float centerPrimary = !vertical ? PMONITOR->m_size.x * 0.5f
-                                        : PMONITOR->m_size.y * 0.5f;
-  const float tileStep = !vertical ? (tileW + gap) : (tileH + gap);
+  layout = computeStripLayout({
+      .monitorW = PMONITOR->m_size.x,
+      .monitorH = PMONITOR->m_size.y,
+      .scale = s,
+      .displayScale = ds,
+      .gap = transitMode ? 0.0f : g_horzaConfig.overviewGap,
+      .vertical = transitMode ? false : g_horzaConfig.vertical,
+      .crossOffset =
+          transitMode
+              ? 0.0f
+              : (m_crossOffset ? m_crossOffset->value() : g_horzaConfig.centerOffset),
+      .primaryOffset = m_offsetX ? m_offsetX->value() : 0.0f,
+      .inactiveScale =
+          transitMode ? 1.0f : g_horzaConfig.inactiveTileSizePercent * 0.01f,
+      .currentIdx = currentIdx,
+  });
   const int renderRadius = std::max(0, g_horzaConfig.livePreviewRadius);
 
   if (g_horzaConfig.hyprpaperBackground && backgroundCaptured) {
@@ -624,7 +756,7 @@ void COverview::fullRender() {
     bgRenderData.damage = &dmg;
     bgRenderData.a = 1.0f;
 
-    auto bgTex = backgroundFb.getTexture();
+    auto bgTex = backgroundFb ? backgroundFb->getTexture() : nullptr;
     if (isRenderableTexture(bgTex))
       g_pHyprOpenGL->renderTextureInternal(bgTex, bgbox, bgRenderData);
     else
@@ -651,21 +783,12 @@ void COverview::fullRender() {
       continue;
     }
 
-    const float baseX = !vertical ? startX + i * (tileW + gap) : startX;
-    const float baseY = !vertical ? startY : startY + i * (tileH + gap);
-    const float tileCenterPrimary =
-        !vertical ? baseX + tileW * 0.5f : baseY + tileH * 0.5f;
-    const float normFromCenter =
-        tileStep > 0.001f
-            ? std::clamp(std::abs(tileCenterPrimary - centerPrimary) / tileStep, 0.0f,
-                         1.0f)
-            : 1.0f;
-    const float tileScaleFactor =
-        1.0f - (1.0f - inactiveTileSizeScale) * normFromCenter;
-    const float drawW = tileW * tileScaleFactor;
-    const float drawH = tileH * tileScaleFactor;
-    const float x = baseX - (drawW - tileW) * 0.5f;
-    const float y = baseY - (drawH - tileH) * 0.5f;
+    float tileScaleFactor = 1.0f;
+    const auto card = stripCardRect(layout, i, &tileScaleFactor);
+    const float x = card.x;
+    const float y = card.y;
+    const float drawW = card.w;
+    const float drawH = card.h;
 
     images[i].displayBox = {x, y, drawW, drawH};
     const bool tileOnScreen = isTileOnScreen(images[i].displayBox);
@@ -778,21 +901,39 @@ void COverview::fullRender() {
                                   fillData);
     };
 
+    // Cards still waiting in the capture queue keep their slot in the strip.
+    auto drawPlaceholder = [&]() {
+      if (tileOnScreen)
+        hasVisibleUncaptured = true;
+
+      drawTileShadow();
+      CHyprOpenGLImpl::SRectRenderData placeholderData;
+      placeholderData.damage = &dmg;
+      placeholderData.roundingPower = 2.0f;
+      placeholderData.round = baseCornerPx;
+      const float placeholderAlpha = std::clamp(0.85f * overlayA, 0.0f, 1.0f);
+      if (placeholderAlpha > 0.0f)
+        g_pHyprOpenGL->renderRect(texbox,
+                                  CHyprColor{0.12, 0.12, 0.12, placeholderAlpha},
+                                  placeholderData);
+      drawDropTargetHighlight();
+      if (!transitMode)
+        renderWorkspaceTitle(i, dmg, s * tileScaleFactor);
+    };
+
     SP<CTexture> tex;
     if (images[i].captured) {
-      tex = images[i].fb.getTexture();
+      tex = images[i].fb ? images[i].fb->getTexture() : nullptr;
       if (!isRenderableTexture(tex)) {
         images[i].captured = false;
-        if (tileOnScreen)
-          hasVisibleUncaptured = true;
+        drawPlaceholder();
         continue;
       }
     } else {
       tex = images[i].cachedTex;
       if (!isRenderableTexture(tex)) {
         images[i].cachedTex.reset();
-        if (tileOnScreen)
-          hasVisibleUncaptured = true;
+        drawPlaceholder();
         continue;
       }
 
@@ -802,6 +943,15 @@ void COverview::fullRender() {
         hasVisibleUncaptured = true;
     }
 
+    // Sample the pre-reduced level once the card is no larger than it.
+    if (images[i].reducedValid && images[i].reducedFb &&
+        images[i].reducedFromCaptureAt == images[i].lastCaptureAt &&
+        texbox.w <= images[i].reducedFb->m_size.x + 1.0) {
+      const auto reducedTex = images[i].reducedFb->getTexture();
+      if (isRenderableTexture(reducedTex))
+        tex = reducedTex;
+    }
+
     drawTileShadow();
 
     CHyprOpenGLImpl::STextureRenderData renderData;
@@ -884,7 +1034,8 @@ void COverview::fullRender() {
       ghostSrcIdx = currentIdx;
     if (ghostSrcIdx >= 0 && ghostSrcIdx < (int)images.size()) {
       if (images[ghostSrcIdx].captured)
-        ghostTex = images[ghostSrcIdx].fb.getTexture();
+        ghostTex = images[ghostSrcIdx].fb ? images[ghostSrcIdx].fb->getTexture()
+                                          : nullptr;
       else
         ghostTex = images[ghostSrcIdx].cachedTex;
     }
@@ -961,6 +1112,12 @@ void COverview::fullRender() {
   }
 
   pendingCapture = hasVisibleUncaptured;
+  flushInputLatency();
+  const float renderMs = std::chrono::duration<float, std::milli>(
+                             std::chrono::steady_clock::now() - renderStartedAt)
+                             .count();
+  frameWorkMs += renderMs;
+  g_horzaStats.renderMs.record(renderMs);
 
   // Optional yalsen-like pump: schedule the next frame from the render pass.
   if (g_horzaConfig.framePumpAggressive && needsFramePump())
@@ -1,5 +1,6 @@
 // Overview workspace-list synchronization (topology detection + image list reconciliation).
 #include "overview.hpp"
+#include "core/workspace_reconcile.hpp"
 #include <algorithm>
 #include <chrono>
 
@@ -8,6 +9,37 @@
 #include <hyprland/src/helpers/Monitor.hpp>
 #undef private
 
+// The one predicate for which workspaces get a card; events, full syncs and
+// the poll must agree or an inert workspace flips in and out of the strip.
+static bool tracksWorkspace(const PHLWORKSPACE& ws, const PHLMONITOR& mon) {
+  return ws && mon && !ws->m_inert && ws->m_id >= 0 && ws->monitorID() == mon->m_id;
+}
+
+namespace {
+
+class CHyprlandCompositorView : public ICompositorView {
+public:
+  void listWorkspaces(std::vector<SWorkspaceInfo>& out) const override {
+    for (const auto& wsWeak : g_pCompositor->m_workspaces) {
+      const auto ws = wsWeak.lock();
+      // collectMonitorWorkspaceIDs adds the monitor and ID half of
+      // tracksWorkspace.
+      if (!ws || ws->m_inert)
+        continue;
+      out.push_back({.id = ws->m_id, .monitorID = (int)ws->monitorID()});
+    }
+  }
+
+  int64_t activeWorkspaceID(int monitorID) const override {
+    const auto mon = g_pCompositor->getMonitorFromID(monitorID);
+    if (!mon || !mon->m_activeWorkspace)
+      return -1;
+    return mon->m_activeWorkspace->m_id;
+  }
+};
+
+} // namespace
+
 bool COverview::needsWorkspaceSync() {
   const auto PMONITOR = pMonitor.lock();
   if (!PMONITOR)
@@ -18,21 +50,13 @@ bool COverview::needsWorkspaceSync() {
       now < nextWorkspaceSyncPollAt)
     return false;
 
-  
-  nextWorkspaceSyncPollAt = now + std::chrono::milliseconds(80);
+  // Topology events are applied incrementally; this poll only catches
+  // anything the events missed.
+  nextWorkspaceSyncPollAt = now + std::chrono::milliseconds(2000);
 
   std::vector<int64_t> workspaceIDs;
   workspaceIDs.reserve(images.size() + 2);
-  for (const auto& wsWeak : g_pCompositor->m_workspaces) {
-    const auto ws = wsWeak.lock();
-    if (!ws)
-      continue;
-    if (ws->monitorID() != PMONITOR->m_id || ws->m_id < 0)
-      continue;
-    workspaceIDs.push_back(ws->m_id);
-  }
-
-  std::sort(workspaceIDs.begin(), workspaceIDs.end());
+  collectMonitorWorkspaceIDs(CHyprlandCompositorView{}, PMONITOR->m_id, workspaceIDs);
   if (workspaceIDs.size() != images.size())
     return true;
 
@@ -45,6 +69,7 @@ bool COverview::needsWorkspaceSync() {
 }
 
 bool COverview::syncWorkspaces() {
+  CTraceSpan traceSpan("syncWorkspaces");
   const auto PMONITOR = pMonitor.lock();
   workspaceListDirty = false;
   if (!PMONITOR)
@@ -53,9 +78,7 @@ bool COverview::syncWorkspaces() {
   std::vector<PHLWORKSPACE> wsList;
   for (auto& wsWeak : g_pCompositor->m_workspaces) {
     auto ws = wsWeak.lock();
-    if (!ws)
-      continue;
-    if (ws->monitorID() == PMONITOR->m_id && ws->m_id >= 0)
+    if (tracksWorkspace(ws, PMONITOR))
       wsList.push_back(ws);
   }
 
@@ -77,26 +100,33 @@ bool COverview::syncWorkspaces() {
   if (unchanged)
     return false;
 
-  PHLWORKSPACE previousCenter = nullptr;
-  if (currentIdx >= 0 && currentIdx < (int)images.size())
-    previousCenter = images[currentIdx].pWorkspace;
+  int64_t previousCenterID = -1;
+  if (currentIdx >= 0 && currentIdx < (int)images.size() &&
+      images[currentIdx].pWorkspace)
+    previousCenterID = images[currentIdx].pWorkspace->m_id;
+
+  std::vector<int64_t> oldIDs;
+  oldIDs.reserve(images.size());
+  for (const auto& img : images)
+    oldIDs.push_back(img.pWorkspace ? img.pWorkspace->m_id : -1);
+  std::vector<int64_t> newIDs;
+  newIDs.reserve(wsList.size());
+  for (const auto& ws : wsList)
+    newIDs.push_back(ws->m_id);
+
+  const auto plan = reconcileWorkspaceList(
+      oldIDs, newIDs, previousCenterID,
+      PMONITOR->m_activeWorkspace ? PMONITOR->m_activeWorkspace->m_id : -1,
+      currentIdx);
 
   auto oldImages = std::move(images);
   const int oldImageCount = (int)oldImages.size();
   images.clear();
   images.reserve(wsList.size());
 
-  for (const auto& ws : wsList) {
-    int oldIdx = -1;
-    for (int i = 0; i < (int)oldImages.size(); ++i) {
-      if (!oldImages[i].pWorkspace)
-        continue;
-      if (oldImages[i].pWorkspace->m_id == ws->m_id) {
-        oldIdx = i;
-        break;
-      }
-    }
-
+  for (size_t n = 0; n < wsList.size(); ++n) {
+    const auto& ws = wsList[n];
+    const int oldIdx = plan.oldIndexFor[n];
     if (oldIdx != -1) {
       auto img = std::move(oldImages[oldIdx]);
       if (img.pWorkspace != ws) {
@@ -107,6 +137,8 @@ bool COverview::syncWorkspaces() {
         img.titleMaxWidthCached = 0;
         img.titleFontCached = 0;
         img.titleFontFamilyCached.clear();
+        img.windowBoxes.clear();
+        img.windowBoxesValid = false;
       }
       img.pWorkspace = ws;
       images.push_back(std::move(img));
@@ -118,30 +150,7 @@ bool COverview::syncWorkspaces() {
   if (images.empty())
     return true;
 
-  int newIdx = -1;
-  if (previousCenter) {
-    for (int i = 0; i < (int)images.size(); ++i) {
-      if (images[i].pWorkspace &&
-          images[i].pWorkspace->m_id == previousCenter->m_id) {
-        newIdx = i;
-        break;
-      }
-    }
-  }
-
-  if (newIdx == -1 && PMONITOR->m_activeWorkspace) {
-    for (int i = 0; i < (int)images.size(); ++i) {
-      if (images[i].pWorkspace &&
-          images[i].pWorkspace->m_id == PMONITOR->m_activeWorkspace->m_id) {
-        newIdx = i;
-        break;
-      }
-    }
-  }
-
-  if (newIdx == -1)
-    newIdx = std::clamp(currentIdx, 0, (int)images.size() - 1);
-  currentIdx = newIdx;
+  currentIdx = plan.currentIdx;
   damageRefreshIdx = -1;
 
   for (int i = 0; i < (int)images.size(); ++i) {
@@ -150,19 +159,16 @@ bool COverview::syncWorkspaces() {
     restoreTileFromCache(i);
   }
 
+  // New cards are captured over the next frames within the capture budget and
+  // drawn as placeholders until then, so a burst of new workspaces (monitor
+  // hot-plug) does not stall a single frame.
   if (g_horzaConfig.prewarmAll) {
-    blockOverviewRendering = true;
     for (int i = 0; i < (int)images.size(); ++i) {
-      if (images[i].captured)
-        continue;
-      images[i].captured = captureWorkspace(i);
-      images[i].cachedTex.reset();
+      if (!images[i].captured)
+        queueWorkspaceCapture(i);
     }
-    blockOverviewRendering = false;
-    pendingCapture = false;
-  } else {
-    pendingCapture = true;
   }
+  pendingCapture = true;
 
   if (currentIdx >= 0 && currentIdx < (int)images.size() &&
       !images[currentIdx].captured)
@@ -172,5 +178,158 @@ bool COverview::syncWorkspaces() {
       dragTargetIdx >= (int)images.size())
     clearDragState();
 
+  g_horzaStats.workspaceSyncs++;
   return true;
 }
+
+int COverview::findWorkspaceCardByID(int64_t workspaceID) const {
+  const auto it = std::lower_bound(
+      images.begin(), images.end(), workspaceID,
+      [](const SWorkspaceImage& img, int64_t id) {
+        return (img.pWorkspace ? img.pWorkspace->m_id : -1) < id;
+      });
+  if (it == images.end() || !it->pWorkspace || it->pWorkspace->m_id != workspaceID)
+    return -1;
+  return (int)(it - images.begin());
+}
+
+int COverview::findWorkspaceCard(const PHLWORKSPACE& ws) const {
+  if (!ws)
+    return -1;
+  const int idx = findWorkspaceCardByID(ws->m_id);
+  if (idx == -1 || images[idx].pWorkspace != ws)
+    return -1;
+  return idx;
+}
+
+void COverview::queueWorkspaceCapture(int idx, bool first) {
+  if (idx < 0 || idx >= (int)images.size() || !images[idx].pWorkspace)
+    return;
+  const int64_t id = images[idx].pWorkspace->m_id;
+  const auto it = std::find(captureQueue.begin(), captureQueue.end(), id);
+  if (!first) {
+    if (it == captureQueue.end())
+      captureQueue.push_back(id);
+    return;
+  }
+  if (it != captureQueue.end())
+    captureQueue.erase(it);
+  captureQueue.push_front(id);
+}
+
+void COverview::insertWorkspaceCard(const PHLWORKSPACE& ws) {
+  const auto it = std::lower_bound(
+      images.begin(), images.end(), ws->m_id, [](const SWorkspaceImage& img, int64_t id) {
+        return (img.pWorkspace ? img.pWorkspace->m_id : -1) < id;
+      });
+  if (it != images.end() && it->pWorkspace && it->pWorkspace->m_id == ws->m_id) {
+    // Same ID, different workspace object: let the full sync reset the card.
+    if (it->pWorkspace != ws)
+      markWorkspaceListDirty();
+    return;
+  }
+
+  const int idx = (int)(it - images.begin());
+  images.insert(it, SWorkspaceImage{.pWorkspace = ws, .captured = false});
+
+  const auto shift = [idx](int& i) {
+    if (i >= idx)
+      i++;
+  };
+  shift(currentIdx);
+  if (damageRefreshIdx != -1)
+    shift(damageRefreshIdx);
+  if (dragSourceIdx != -1)
+    shift(dragSourceIdx);
+  if (dragTargetIdx != -1)
+    shift(dragTargetIdx);
+
+  restoreTileFromCache(idx);
+  if (g_horzaConfig.prewarmAll)
+    queueWorkspaceCapture(idx);
+  pendingCapture = true;
+  g_horzaStats.workspaceIncrementalSyncs++;
+  damage();
+}
+
+void COverview::removeWorkspaceCard(int idx) {
+  if (idx < 0 || idx >= (int)images.size())
+    return;
+
+  const bool wasCurrent = idx == currentIdx;
+  images.erase(images.begin() + idx);
+
+  const auto shift = [idx](int& i) {
+    if (i == idx)
+      i = -1;
+    else if (i > idx)
+      i--;
+  };
+  if (dragSourceIdx == idx)
+    clearDragState();
+  if (dragSourceIdx != -1)
+    shift(dragSourceIdx);
+  if (dragTargetIdx != -1)
+    shift(dragTargetIdx);
+  if (damageRefreshIdx != -1)
+    shift(damageRefreshIdx);
+
+  g_horzaStats.workspaceIncrementalSyncs++;
+  // An empty list is handled (overview dropped) by the next pre-render.
+  if (images.empty()) {
+    currentIdx = 0;
+    damage();
+    return;
+  }
+
+  if (wasCurrent) {
+    const auto PMONITOR = pMonitor.lock();
+    const int activeIdx =
+        PMONITOR ? findWorkspaceCard(PMONITOR->m_activeWorkspace) : -1;
+    currentIdx =
+        activeIdx != -1 ? activeIdx : std::clamp(idx, 0, (int)images.size() - 1);
+    if (!images[currentIdx].captured)
+      damageDirty = true;
+  } else if (idx < currentIdx) {
+    currentIdx--;
+  }
+  damage();
+}
+
+void COverview::onWorkspaceCreated(const PHLWORKSPACE& ws) {
+  g_horzaStats.workspaceSyncEvents++;
+  if (closing)
+    return;
+  if (tracksWorkspace(ws, pMonitor.lock()))
+    insertWorkspaceCard(ws);
+}
+
+void COverview::onWorkspaceRemoved(const PHLWORKSPACE& ws) {
+  g_horzaStats.workspaceSyncEvents++;
+  if (closing)
+    return;
+  // The payload can already be gone; only a full sync can tell which card.
+  if (!ws) {
+    markWorkspaceListDirty();
+    return;
+  }
+  removeWorkspaceCard(findWorkspaceCard(ws));
+}
+
+void COverview::onWorkspaceMoved(const PHLWORKSPACE& ws, const PHLMONITOR& mon) {
+  g_horzaStats.workspaceSyncEvents++;
+  frozenAnimVarsDirty = true;
+  if (closing || !ws)
+    return;
+
+  const auto PMONITOR = pMonitor.lock();
+  if (!PMONITOR)
+    return;
+
+  const int idx = findWorkspaceCard(ws);
+  const bool toUs = mon && mon->m_id == PMONITOR->m_id;
+  if (toUs && idx == -1 && tracksWorkspace(ws, PMONITOR))
+    insertWorkspaceCard(ws);
+  else if (!toUs && idx != -1)
+    removeWorkspaceCard(idx);
+}
@@ -1,18 +1,40 @@
 #include "plugin_runtime.hpp"
 
 #include "config.hpp"
+#include "core/capture_schedule.hpp"
 #include "globals.hpp"
 #include "overview.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 
 #include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/debug/log/Logger.hpp>
 #include <hyprland/src/desktop/state/FocusState.hpp>
 #include <hyprland/src/event/EventBus.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/managers/KeybindManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/render/Renderer.hpp>
 
+// Recently used workspaces kept per monitor, besides the active one.
+static constexpr size_t PREFETCH_RECENT_WORKSPACES = 2;
+
+static std::chrono::milliseconds prefetchTickInterval() {
+  return std::chrono::milliseconds(
+      (int64_t)std::max(100.0f, g_horzaConfig.idlePrefetchIntervalMs));
+}
+
+static std::chrono::milliseconds leaveCaptureDelay() {
+  return std::chrono::milliseconds(
+      (int64_t)std::max(16.0f, g_horzaConfig.captureOnLeaveIntervalMs));
+}
+
 CPluginRuntime::~CPluginRuntime() { shutdown(); }
 
 void CPluginRuntime::init(const std::function<void()>& onConfigReload) {
@@ -29,7 +51,7 @@ void CPluginRuntime::init(const std::function<void()>& onConfigReload) {
     renderWorkspaceHook = HyprlandAPI::createFunctionHook(
         PHANDLE, methods[0].address, (void*)hkRenderWorkspaceBridge);
 
-    if (!renderWorkspaceHook || !renderWorkspaceHook->hook())
+    if (!renderWorkspaceHook)
       throw std::runtime_error("[horza] failed to hook renderWorkspace");
   }
 
@@ -39,7 +61,7 @@ void CPluginRuntime::init(const std::function<void()>& onConfigReload) {
     if (!methods.empty()) {
       addDamageHookA = HyprlandAPI::createFunctionHook(
           PHANDLE, methods[0].address, (void*)hkAddDamageABridge);
-      if (!addDamageHookA || !addDamageHookA->hook())
+      if (!addDamageHookA)
         throw std::runtime_error("[horza] failed to hook addDamage(CBox)");
     }
   }
@@ -50,7 +72,7 @@ void CPluginRuntime::init(const std::function<void()>& onConfigReload) {
     if (!methods.empty()) {
       addDamageHookB = HyprlandAPI::createFunctionHook(
           PHANDLE, methods[0].address, (void*)hkAddDamageBBridge);
-      if (!addDamageHookB || !addDamageHookB->hook())
+      if (!addDamageHookB)
         throw std::runtime_error("[horza] failed to hook addDamage(region)");
     }
   }
@@ -60,59 +82,187 @@ void CPluginRuntime::init(const std::function<void()>& onConfigReload) {
   HyprlandAPI::addDispatcherV2(PHANDLE, "horza:workspace",
                                dispatchWorkspaceTransitBridge);
 
+  hyprctlCommand = HyprlandAPI::registerHyprCtlCommand(
+      PHANDLE, SHyprCtlCommand{.name = "horza", .exact = false,
+                               .fn = hyprctlHorzaBridge});
+
   if (auto* bus = Event::bus().get()) {
     if (onConfigReloadCallback) {
       configReloadListener =
           bus->m_events.config.reloaded.listen(
-              [this]() { onConfigReloadCallback(); });
+              [this]() {
+                onConfigReloadCallback();
+                armPrefetch();
+              });
     }
 
+    workspaceActiveListener = bus->m_events.workspace.active.listen(
+        [this](PHLWORKSPACE ws) { onWorkspaceActivated(ws); });
+    workspaceRemovedListener = bus->m_events.workspace.removed.listen(
+        [](PHLWORKSPACEREF ws) {
+          if (const auto PWS = ws.lock())
+            forgetWorkspaceContent(PWS->m_id);
+        });
+
+    const auto windowWorkspaceChanged = [this](const PHLWINDOW& window) {
+      if (window && window->m_workspace)
+        onWorkspaceContentChanged(window->m_workspace->m_id);
+    };
+    windowOpenListener = bus->m_events.window.open.listen(
+        [windowWorkspaceChanged](PHLWINDOW window) { windowWorkspaceChanged(window); });
+    windowCloseListener = bus->m_events.window.close.listen(
+        [windowWorkspaceChanged](PHLWINDOW window) { windowWorkspaceChanged(window); });
+    windowMoveListener = bus->m_events.window.moveToWorkspace.listen(
+        [this, windowWorkspaceChanged](PHLWINDOW window, PHLWORKSPACE ws) {
+          windowWorkspaceChanged(window);
+          if (ws)
+            onWorkspaceContentChanged(ws->m_id);
+        });
+    renderViaStage = true;
+  } else {
+    renderViaStage = false;
+  }
+
+  // The prefetch timer only runs while some candidate tile is missing or
+  // outdated; workspace and window changes re-arm it.
+  prefetchTimer = makeShared<CEventLoopTimer>(
+      prefetchTickInterval(),
+      [this](SP<CEventLoopTimer> self, void*) {
+        if (onPrefetchTick())
+          self->updateTimeout(prefetchTickInterval());
+        else
+          self->updateTimeout(std::nullopt);
+      },
+      nullptr);
+  g_pEventLoopManager->addTimer(prefetchTimer);
+
+  // Leave snapshots run from their own timer once the switch has settled,
+  // never inside the workspace.active event.
+  leaveCaptureTimer = makeShared<CEventLoopTimer>(
+      std::nullopt,
+      [this](SP<CEventLoopTimer> self, void*) {
+        if (onLeaveCaptureTick())
+          self->updateTimeout(leaveCaptureDelay());
+        else
+          self->updateTimeout(std::nullopt);
+      },
+      nullptr);
+  g_pEventLoopManager->addTimer(leaveCaptureTimer);
+
+  initialized = true;
+}
+
+bool CPluginRuntime::installFunctionHooks() {
+  if (functionHooksInstalled)
+    return true;
+  // Each hook() builds a trampoline that is never freed, so a failed install
+  // is not retried.
+  if (functionHooksFailed || !renderWorkspaceHook)
+    return false;
+
+  for (auto* hook : {renderWorkspaceHook, addDamageHookA, addDamageHookB}) {
+    if (hook && !hook->hook()) {
+      Log::logger->log(Log::ERR, "[horza] failed to install function hooks");
+      functionHooksFailed = true;
+      return false;
+    }
+  }
+  functionHooksInstalled = true;
+  return true;
+}
+
+bool CPluginRuntime::acquireOverviewHooks() {
+  if (overviewHooksInstalled)
+    return true;
+  // The function hooks go in on the first open and stay; with no overview
+  // they return after one g_overviews.empty() check.
+  if (!installFunctionHooks())
+    return false;
+
+  if (auto* bus = Event::bus().get()) {
     renderStageListener =
-        bus->m_events.render.stage.listen([this](eRenderStage stage) {
+        bus->m_events.render.stage.listen([](eRenderStage stage) {
           if (stage != RENDER_LAST_MOMENT)
             return;
 
-          auto* ov = g_pOverview.get();
-          if (!ov || ov->blockOverviewRendering)
-            return;
-          if (ov->closeDropPending())
-            return;
-
-          const auto ovMon = ov->pMonitor.lock();
-          if (!ovMon)
+          if (g_overviews.empty())
             return;
-
           if (!g_pHyprOpenGL || !g_pHyprOpenGL->m_renderData.pMonitor)
             return;
           const auto stageMon = g_pHyprOpenGL->m_renderData.pMonitor.lock();
-          if (!stageMon || stageMon->m_id != ovMon->m_id)
+
+          auto* ov = overviewForMonitor(stageMon.get());
+          if (!ov || ov->blockOverviewRendering)
+            return;
+          if (ov->closeDropPending())
             return;
 
           ov->render();
         });
-    renderViaStage = true;
-  } else {
-    renderViaStage = false;
   }
 
-  initialized = true;
+  overviewHooksInstalled = true;
+  return true;
+}
+
+void CPluginRuntime::releaseOverviewHooks() {
+  if (!overviewHooksInstalled)
+    return;
+
+  renderStageListener.reset();
+  overviewHooksInstalled = false;
+}
+
+void CPluginRuntime::releaseOverviewHooksLater() {
+  if (hookReleaseScheduled)
+    return;
+  hookReleaseScheduled = true;
+
+  // Never drop the stage listener from inside a render; the close drop runs
+  // in one.
+  g_pEventLoopManager->doLater([]() {
+    if (!g_pPluginRuntime)
+      return;
+    g_pPluginRuntime->hookReleaseScheduled = false;
+    if (g_overviews.empty())
+      g_pPluginRuntime->releaseOverviewHooks();
+  });
 }
 
 void CPluginRuntime::shutdown() {
-  if (addDamageHookA) {
-    addDamageHookA->unhook();
-    addDamageHookA = nullptr;
-  }
-  if (addDamageHookB) {
-    addDamageHookB->unhook();
-    addDamageHookB = nullptr;
+  g_horzaTracer.stop();
+  releaseOverviewHooks();
+  if (functionHooksInstalled) {
+    for (auto* hook : {addDamageHookA, addDamageHookB, renderWorkspaceHook}) {
+      if (hook)
+        hook->unhook();
+    }
+    functionHooksInstalled = false;
   }
-  if (renderWorkspaceHook) {
-    renderWorkspaceHook->unhook();
-    renderWorkspaceHook = nullptr;
+  addDamageHookA = nullptr;
+  addDamageHookB = nullptr;
+  renderWorkspaceHook = nullptr;
+
+  if (hyprctlCommand) {
+    HyprlandAPI::unregisterHyprCtlCommand(PHANDLE, hyprctlCommand);
+    hyprctlCommand.reset();
   }
 
-  renderStageListener.reset();
+  workspaceActiveListener.reset();
+  workspaceRemovedListener.reset();
+  windowOpenListener.reset();
+  windowCloseListener.reset();
+  windowMoveListener.reset();
+  if (prefetchTimer) {
+    g_pEventLoopManager->removeTimer(prefetchTimer);
+    prefetchTimer.reset();
+  }
+  if (leaveCaptureTimer) {
+    g_pEventLoopManager->removeTimer(leaveCaptureTimer);
+    leaveCaptureTimer.reset();
+  }
+  pendingLeaveCaptures.clear();
+  recentWorkspaces.clear();
   renderViaStage = false;
   configReloadListener.reset();
   onConfigReloadCallback = nullptr;
@@ -130,30 +280,26 @@ void CPluginRuntime::hookRenderWorkspace(void* thisptr, PHLMONITOR monitor,
         thisptr, monitor, workspace, now, geometry);
   };
 
-  auto* ov = g_pOverview.get();
-  if (!ov || !monitor || renderingOverview) {
+  if (g_overviews.empty()) {
     callOriginal();
     return;
   }
 
-  if (ov->closeDropPending()) {
-    const auto mon = ov->pMonitor.lock();
-    g_pOverview.reset();
-    if (mon) {
-      g_pHyprRenderer->damageMonitor(mon);
-      g_pCompositor->scheduleFrameForMonitor(mon);
-    }
+  auto* ov = overviewForMonitor(monitor.get());
+  if (!ov || renderingOverview) {
     callOriginal();
     return;
   }
 
-  if (ov->blockOverviewRendering) {
+  if (ov->closeDropPending()) {
+    destroyOverview(ov);
+    g_pHyprRenderer->damageMonitor(monitor);
+    g_pCompositor->scheduleFrameForMonitor(monitor);
     callOriginal();
     return;
   }
 
-  const auto ovMon = ov->pMonitor.lock();
-  if (!ovMon || ovMon->m_id != monitor->m_id) {
+  if (ov->blockOverviewRendering) {
     callOriginal();
     return;
   }
@@ -169,15 +315,17 @@ void CPluginRuntime::hookAddDamageA(void* thisptr, const CBox& box) {
     (*(origAddDamageA_t)addDamageHookA->m_original)(thisptr, box);
   };
 
-  const auto mon = reinterpret_cast<CMonitor*>(thisptr);
-  auto* ov = g_pOverview.get();
-  if (!ov || !mon) {
+  if (blockSnapshotDamage) {
+    g_horzaStats.snapshotDamageDropped++;
+    return;
+  }
+  if (g_overviews.empty()) {
     callOriginal();
     return;
   }
 
-  const auto ovMon = ov->pMonitor.lock();
-  if (!ovMon || ovMon->m_id != mon->m_id || ov->blockDamageReporting) {
+  auto* ov = overviewForMonitor(reinterpret_cast<CMonitor*>(thisptr));
+  if (!ov || ov->blockDamageReporting) {
     callOriginal();
     return;
   }
@@ -192,15 +340,17 @@ void CPluginRuntime::hookAddDamageB(void* thisptr, const pixman_region32_t* rg)
     (*(origAddDamageB_t)addDamageHookB->m_original)(thisptr, rg);
   };
 
-  const auto mon = reinterpret_cast<CMonitor*>(thisptr);
-  auto* ov = g_pOverview.get();
-  if (!ov || !mon) {
+  if (blockSnapshotDamage) {
+    g_horzaStats.snapshotDamageDropped++;
+    return;
+  }
+  if (g_overviews.empty()) {
     callOriginal();
     return;
   }
 
-  const auto ovMon = ov->pMonitor.lock();
-  if (!ovMon || ovMon->m_id != mon->m_id || ov->blockDamageReporting) {
+  auto* ov = overviewForMonitor(reinterpret_cast<CMonitor*>(thisptr));
+  if (!ov || ov->blockDamageReporting) {
     callOriginal();
     return;
   }
@@ -208,37 +358,158 @@ void CPluginRuntime::hookAddDamageB(void* thisptr, const pixman_region32_t* rg)
   ov->onDamageReported();
 }
 
+std::string CPluginRuntime::hyprctlHorza(eHyprCtlOutputFormat format,
+                                         std::string request) {
+  const bool json = format == eHyprCtlOutputFormat::FORMAT_JSON;
+
+  std::vector<std::string> rawArgs;
+  std::vector<std::string> args;
+  std::istringstream in(request);
+  for (std::string tok; in >> tok;) {
+    rawArgs.push_back(tok);
+    args.push_back(normalizeHorzaToken(tok));
+  }
+  // args[0] is the command name itself.
+  if (args.size() >= 2 && args[1] == "latency") {
+    if (args.size() >= 3 && args[2] == "reset") {
+      for (auto& h : g_horzaStats.inputLatency)
+        h.reset();
+      return "ok";
+    }
+    return formatInputLatencyReport(json);
+  }
+  if (args.size() >= 2 && args[1] == "stats") {
+    if (args.size() >= 3 && args[2] == "reset") {
+      g_horzaStats.reset();
+      return "ok";
+    }
+
+    SHorzaLiveUsage live;
+    workspaceTileCacheUsage(live.tileCacheEntries, live.tileCacheBytes);
+    for (const auto& ov : g_overviews) {
+      live.overviewOpen |= !ov->closing;
+      live.framebufferBytes += ov->framebufferBytes();
+    }
+    return formatHorzaStatsReport(live, json);
+  }
+  if (args.size() >= 2 && args[1] == "trace") {
+    const std::string sub = args.size() >= 3 ? args[2] : "status";
+    if (sub == "start") {
+      g_horzaTracer.start();
+      return "ok";
+    }
+    if (sub == "stop") {
+      g_horzaTracer.stop();
+      return "ok";
+    }
+    if (sub == "dump") {
+      const std::string path =
+          rawArgs.size() >= 4 ? rawArgs[3] : "/tmp/horza-trace.json";
+      std::string error;
+      if (!g_horzaTracer.dump(path, error))
+        return "error: " + error;
+      return std::format("wrote {} events to {}", g_horzaTracer.recorded(), path);
+    }
+    return std::format("tracing {}, {} events buffered",
+                       g_horzaTracer.enabled() ? "on" : "off",
+                       g_horzaTracer.recorded());
+  }
+
+  if (args.size() >= 3 && args[1] == "bench" && args[2] == "damage") {
+    int iterations = 100000;
+    if (args.size() >= 4) {
+      try {
+        iterations = std::stoi(args[3]);
+      } catch (...) {
+        return "error: iteration count must be a number";
+      }
+    }
+    return benchDamage(std::clamp(iterations, 1, 10000000), json);
+  }
+
+  return "usage: hyprctl horza <stats|latency> [reset] | trace <start|stop|dump [path]> | "
+         "bench damage [n]";
+}
+
+std::string CPluginRuntime::benchDamage(int iterations, bool json) {
+  if (!g_overviews.empty())
+    return "error: close the overview first";
+  const auto mon = Desktop::focusState()->monitor();
+  if (!mon)
+    return "error: no focused monitor";
+
+  // The hooks stay once installed, so the unhooked cost is measured by
+  // calling the original function the trampoline jumps to.
+  if (!installFunctionHooks() || !addDamageHookA)
+    return "error: failed to install render hooks";
+
+  const CBox box = {0.0, 0.0, 1.0, 1.0};
+  const auto nsPerCall = [&](auto&& call) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      call();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                    start)
+               .count() /
+           iterations;
+  };
+
+  const auto original = (origAddDamageA_t)addDamageHookA->m_original;
+  const double unhooked = nsPerCall([&]() { (*original)(mon.get(), box); });
+  const double hooked = nsPerCall([&]() { mon->addDamage(box); });
+
+  if (json)
+    return std::format("{{\"iterations\": {}, \"unhooked_ns\": {:.1f}, "
+                       "\"hooked_ns\": {:.1f}}}",
+                       iterations, unhooked, hooked);
+  return std::format("addDamage x{}: {:.1f} ns/call unhooked, {:.1f} ns/call hooked "
+                     "({:+.1f} ns)\n",
+                     iterations, unhooked, hooked, hooked - unhooked);
+}
+
 SDispatchResult CPluginRuntime::dispatchToggle(std::string arg) {
   (void)arg;
-  if (g_pOverview) {
-    if (!g_pOverview->ready) {
-      g_pOverview.reset();
-      return {};
-    }
-    if (g_pOverview->closing)
-      g_pOverview->reopen();
+  // Only ready overviews are ever registered.
+  if (auto* ov = focusedOverview()) {
+    // close() and reopen() carry the other monitors along.
+    if (ov->closing)
+      ov->reopen();
     else
-      g_pOverview->close();
+      ov->close();
     return {};
   }
 
-  const auto mon = Desktop::focusState()->monitor();
-  if (!mon || !mon->m_activeWorkspace)
+  const auto focusedMon = Desktop::focusState()->monitor();
+  if (!focusedMon || !focusedMon->m_activeWorkspace)
     return {};
 
-  renderingOverview = true;
-  g_pOverview = std::make_unique<COverview>(mon->m_activeWorkspace);
-  renderingOverview = false;
-
-  if (!g_pOverview || !g_pOverview->ready) {
-    g_pOverview.reset();
-    return {};
+  std::vector<PHLMONITOR> monitors = {focusedMon};
+  if (g_horzaConfig.allMonitors) {
+    for (const auto& mon : g_pCompositor->m_monitors) {
+      if (mon && mon != focusedMon && mon->m_enabled && mon->m_activeWorkspace)
+        monitors.push_back(mon);
+    }
   }
 
-  if (auto ovMon = g_pOverview->pMonitor.lock()) {
-    g_pHyprRenderer->damageMonitor(ovMon);
-    g_pCompositor->scheduleFrameForMonitor(ovMon);
+  if (!acquireOverviewHooks())
+    return {.success = false, .error = "horza: failed to install render hooks"};
+
+  const auto inputAt = std::chrono::steady_clock::now();
+  for (const auto& mon : monitors) {
+    renderingOverview = true;
+    auto ov = std::make_unique<COverview>(mon->m_activeWorkspace);
+    renderingOverview = false;
+    if (!ov->ready)
+      continue;
+
+    if (mon == focusedMon)
+      ov->notePendingInput(INPUT_LATENCY_OPEN, inputAt);
+    g_overviews.push_back(std::move(ov));
+    g_pHyprRenderer->damageMonitor(mon);
+    g_pCompositor->scheduleFrameForMonitor(mon);
   }
+  if (g_overviews.empty())
+    releaseOverviewHooksLater();
 
   return {};
 }
@@ -277,7 +548,118 @@ PHLWORKSPACE CPluginRuntime::resolveWorkspaceFromArg(const std::string& arg,
   return ws;
 }
 
+void CPluginRuntime::onWorkspaceActivated(PHLWORKSPACE ws) {
+  if (!ws || ws->m_isSpecialWorkspace)
+    return;
+  const auto mon = g_pCompositor->getMonitorFromID(ws->monitorID());
+  if (!mon)
+    return;
+
+  auto& recent = recentWorkspaces[mon->m_id];
+  std::erase_if(recent, [](const PHLWORKSPACEREF& ref) { return !ref.lock(); });
+  const auto previous = recent.empty() ? nullptr : recent.front().lock();
+  std::erase_if(recent, [&](const PHLWORKSPACEREF& ref) { return ref.lock() == ws; });
+  recent.insert(recent.begin(), ws);
+  if (recent.size() > PREFETCH_RECENT_WORKSPACES + 1)
+    recent.resize(PREFETCH_RECENT_WORKSPACES + 1);
+
+  // A shown workspace changes under its tile; a left one may have changed
+  // since its last snapshot.
+  noteWorkspaceContentChanged(ws->m_id);
+  armPrefetch();
+  if (!previous || previous == ws || previous->monitorID() != mon->m_id)
+    return;
+  noteWorkspaceContentChanged(previous->m_id);
+
+  // An open overview keeps its own cards fresh.
+  if (!g_horzaConfig.captureOnLeave || overviewForMonitor(mon.get()))
+    return;
+
+  if (std::ranges::none_of(pendingLeaveCaptures, [&](const PHLWORKSPACEREF& ref) {
+        return ref.lock() == previous;
+      }))
+    pendingLeaveCaptures.emplace_back(previous);
+  if (leaveCaptureTimer && !leaveCaptureTimer->armed())
+    leaveCaptureTimer->updateTimeout(leaveCaptureDelay());
+}
+
+bool CPluginRuntime::onLeaveCaptureTick() {
+  if (!g_overviews.empty()) {
+    pendingLeaveCaptures.clear();
+    return false;
+  }
+
+  // Workspaces shown again since they were left need no snapshot.
+  std::erase_if(pendingLeaveCaptures, [](const PHLWORKSPACEREF& ref) {
+    const auto ws = ref.lock();
+    if (!ws)
+      return true;
+    const auto mon = g_pCompositor->getMonitorFromID(ws->monitorID());
+    return !mon || mon->m_activeWorkspace == ws;
+  });
+  if (pendingLeaveCaptures.empty())
+    return false;
+
+  const auto ws = pendingLeaveCaptures.front().lock();
+  const auto mon = g_pCompositor->getMonitorFromID(ws->monitorID());
+  // Wait for the switch animation; the next tick retries.
+  if (!workspaceSettled(ws) ||
+      (mon->m_activeWorkspace && !workspaceSettled(mon->m_activeWorkspace)))
+    return true;
+
+  captureLeavingWorkspace(mon, ws);
+  pendingLeaveCaptures.erase(pendingLeaveCaptures.begin());
+  return !pendingLeaveCaptures.empty();
+}
+
+void CPluginRuntime::armPrefetch() {
+  if (prefetchTimer && g_horzaConfig.idlePrefetch && !prefetchTimer->armed())
+    prefetchTimer->updateTimeout(prefetchTickInterval());
+}
+
+void CPluginRuntime::onWorkspaceContentChanged(int64_t workspaceID) {
+  noteWorkspaceContentChanged(workspaceID);
+  armPrefetch();
+}
+
+bool CPluginRuntime::onPrefetchTick() {
+  if (!g_horzaConfig.idlePrefetch || !g_overviews.empty())
+    return false;
+
+  const auto mon = Desktop::focusState()->monitor();
+  if (!mon || !mon->m_dpmsStatus || !mon->m_activeWorkspace)
+    return false;
+  const auto active = mon->m_activeWorkspace;
+  // Leave a workspace switch in flight alone; the next tick catches up.
+  if (!workspaceSettled(active))
+    return true;
+
+  std::vector<int64_t> recentIDs;
+  if (const auto it = recentWorkspaces.find(mon->m_id); it != recentWorkspaces.end()) {
+    for (const auto& ref : it->second) {
+      if (const auto ws = ref.lock())
+        recentIDs.push_back(ws->m_id);
+    }
+  }
+
+  std::vector<int64_t> ids;
+  pickPrefetchWorkspaces(
+      active->m_id, recentIDs, 2 + PREFETCH_RECENT_WORKSPACES,
+      [&](int64_t id) {
+        const auto ws = g_pCompositor->getWorkspaceByID(id);
+        return ws && !ws->m_isSpecialWorkspace && ws->monitorID() == mon->m_id;
+      },
+      ids);
+
+  std::vector<PHLWORKSPACE> candidates;
+  candidates.reserve(ids.size());
+  for (const int64_t id : ids)
+    candidates.push_back(g_pCompositor->getWorkspaceByID(id));
+  return prefetchWorkspaceTile(mon, candidates);
+}
+
 SDispatchResult CPluginRuntime::dispatchWorkspaceTransit(std::string arg) {
+  const auto inputAt = std::chrono::steady_clock::now();
   const auto workspaceDispatcher =
       g_pKeybindManager->m_dispatchers.find("workspace");
   if (workspaceDispatcher == g_pKeybindManager->m_dispatchers.end())
@@ -293,7 +675,14 @@ SDispatchResult CPluginRuntime::dispatchWorkspaceTransit(std::string arg) {
     return {};
   }
 
-  if (g_pOverview) {
+  if (auto* ov = overviewForMonitor(mon.get())) {
+    ov->notePendingInput(INPUT_LATENCY_WORKSPACE_DISPATCH, inputAt);
+    dispatchWorkspace(arg);
+    return {};
+  }
+  // A transit would join the open overviews' close()/reopen() cascade and
+  // compete for keyboard input; switch plainly instead.
+  if (!g_overviews.empty()) {
     dispatchWorkspace(arg);
     return {};
   }
@@ -304,20 +693,25 @@ SDispatchResult CPluginRuntime::dispatchWorkspaceTransit(std::string arg) {
     return {};
   }
 
+  if (!acquireOverviewHooks()) {
+    dispatchWorkspace(arg);
+    return {};
+  }
+
   renderingOverview = true;
-  g_pOverview = std::make_unique<COverview>(mon->m_activeWorkspace, true, dest);
+  auto ov = std::make_unique<COverview>(mon->m_activeWorkspace, true, dest);
   renderingOverview = false;
 
-  if (!g_pOverview || !g_pOverview->ready) {
-    g_pOverview.reset();
+  if (!ov->ready) {
+    releaseOverviewHooksLater();
     dispatchWorkspace(arg);
     return {};
   }
 
-  if (auto ovMon = g_pOverview->pMonitor.lock()) {
-    g_pHyprRenderer->damageMonitor(ovMon);
-    g_pCompositor->scheduleFrameForMonitor(ovMon);
-  }
+  ov->notePendingInput(INPUT_LATENCY_WORKSPACE_DISPATCH, inputAt);
+  g_overviews.push_back(std::move(ov));
+  g_pHyprRenderer->damageMonitor(mon);
+  g_pCompositor->scheduleFrameForMonitor(mon);
 
   dispatchWorkspace(arg);
   return {};
@@ -346,6 +740,13 @@ void CPluginRuntime::hkAddDamageBBridge(void* thisptr,
   g_pPluginRuntime->hookAddDamageB(thisptr, rg);
 }
 
+std::string CPluginRuntime::hyprctlHorzaBridge(eHyprCtlOutputFormat format,
+                                               std::string request) {
+  if (!g_pPluginRuntime)
+    return "horza not initialized";
+  return g_pPluginRuntime->hyprctlHorza(format, request);
+}
+
 SDispatchResult CPluginRuntime::dispatchToggleBridge(std::string arg) {
   if (!g_pPluginRuntime)
     return {};
@@ -5,11 +5,14 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/helpers/math/Math.hpp>
 #include <hyprland/src/helpers/time/Time.hpp>
 #include <hyprland/src/plugins/PluginAPI.hpp>
 
+class CEventLoopTimer;
 struct pixman_region32;
 using pixman_region32_t = struct pixman_region32;
 
@@ -21,6 +24,16 @@ public:
   void init(const std::function<void()>& onConfigReload);
   void shutdown();
 
+  // The render/damage hooks are installed on first use and stay; the render
+  // stage listener is only subscribed while an overview exists.
+  bool acquireOverviewHooks();
+  void releaseOverviewHooksLater();
+  bool installFunctionHooks();
+
+  // Set around snapshots taken while closed: warping a workspace's offset and
+  // alpha damages its monitor, and the damage hooks drop that damage.
+  bool blockSnapshotDamage = false;
+
 private:
   using origRenderWorkspace_t =
       void (*)(void*, PHLMONITOR, PHLWORKSPACE, const Time::steady_tp&,
@@ -34,10 +47,18 @@ private:
   void hookAddDamageA(void* thisptr, const CBox& box);
   void hookAddDamageB(void* thisptr, const pixman_region32_t* rg);
 
+  std::string hyprctlHorza(eHyprCtlOutputFormat format, std::string request);
   SDispatchResult dispatchToggle(std::string arg);
   SDispatchResult dispatchWorkspaceTransit(std::string arg);
   PHLWORKSPACE resolveWorkspaceFromArg(const std::string& arg,
                                        PHLMONITOR mon) const;
+  void onWorkspaceActivated(PHLWORKSPACE ws);
+  bool onPrefetchTick();
+  bool onLeaveCaptureTick();
+  void armPrefetch();
+  void onWorkspaceContentChanged(int64_t workspaceID);
+  void releaseOverviewHooks();
+  std::string benchDamage(int iterations, bool json);
 
   static void hkRenderWorkspaceBridge(void* thisptr, PHLMONITOR monitor,
                                       PHLWORKSPACE workspace,
@@ -45,16 +66,35 @@ private:
                                       const CBox& geometry);
   static void hkAddDamageABridge(void* thisptr, const CBox& box);
   static void hkAddDamageBBridge(void* thisptr, const pixman_region32_t* rg);
+  static std::string hyprctlHorzaBridge(eHyprCtlOutputFormat format,
+                                        std::string request);
   static SDispatchResult dispatchToggleBridge(std::string arg);
   static SDispatchResult dispatchWorkspaceTransitBridge(std::string arg);
 
   bool initialized = false;
   bool renderingOverview = false;
   bool renderViaStage = false;
+  bool functionHooksInstalled = false;
+  bool functionHooksFailed = false;
+  // Whether the render stage listener is subscribed.
+  bool overviewHooksInstalled = false;
+  bool hookReleaseScheduled = false;
 
   std::function<void()> onConfigReloadCallback;
   std::any configReloadListener;
   std::any renderStageListener;
+  std::any workspaceActiveListener;
+  std::any workspaceRemovedListener;
+  std::any windowOpenListener;
+  std::any windowCloseListener;
+  std::any windowMoveListener;
+  // Per monitor, most recently active first; front is the active workspace.
+  std::unordered_map<int64_t, std::vector<PHLWORKSPACEREF>> recentWorkspaces;
+  SP<CEventLoopTimer> prefetchTimer;
+  // Workspaces left while no overview was open, oldest first.
+  std::vector<PHLWORKSPACEREF> pendingLeaveCaptures;
+  SP<CEventLoopTimer> leaveCaptureTimer;
+  SP<SHyprCtlCommand> hyprctlCommand;
 
   CFunctionHook* renderWorkspaceHook = nullptr;
   CFunctionHook* addDamageHookA = nullptr;
@@ -0,0 +1,158 @@
+#include "stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <vector>
+
+void CLatencyHistogram::record(float ms) {
+  if (!std::isfinite(ms) || ms < 0.0f)
+    return;
+  samples[nextSlot] = ms;
+  nextSlot = (nextSlot + 1) % CAPACITY;
+  stored = std::min(stored + 1, CAPACITY);
+  totalSamples++;
+}
+
+void CLatencyHistogram::reset() {
+  nextSlot = 0;
+  stored = 0;
+  totalSamples = 0;
+}
+
+float CLatencyHistogram::last() const {
+  if (stored == 0)
+    return 0.0f;
+  return samples[(nextSlot + CAPACITY - 1) % CAPACITY];
+}
+
+float CLatencyHistogram::percentile(float p) const {
+  if (stored == 0)
+    return 0.0f;
+
+  std::vector<float> sorted(samples.begin(), samples.begin() + stored);
+  // Nearest-rank percentile.
+  const double wanted = std::ceil(std::clamp(p, 0.0f, 1.0f) * (double)stored);
+  const size_t rank = std::clamp<size_t>((size_t)std::max(1.0, wanted) - 1, 0, stored - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+const char* inputLatencyKindName(eInputLatencyKind kind) {
+  switch (kind) {
+  case INPUT_LATENCY_SCROLL:
+    return "scroll";
+  case INPUT_LATENCY_DRAG_HOVER:
+    return "drag_hover";
+  case INPUT_LATENCY_WORKSPACE_DISPATCH:
+    return "workspace_dispatch";
+  case INPUT_LATENCY_OPEN:
+    return "open";
+  case INPUT_LATENCY_KEY:
+    return "key";
+  default:
+    return "unknown";
+  }
+}
+
+void SHorzaStats::reset() { *this = SHorzaStats{}; }
+
+static std::string formatHistogram(const char* name, const CLatencyHistogram& h,
+                                   bool json) {
+  if (json)
+    return std::format("\"{}\": {{\"count\": {}, \"last_ms\": {:.3f}, "
+                       "\"p50_ms\": {:.3f}, \"p95_ms\": {:.3f}, \"p99_ms\": {:.3f}}}",
+                       name, h.total(), h.last(), h.percentile(0.50f),
+                       h.percentile(0.95f), h.percentile(0.99f));
+  return std::format("{}: count={} last={:.2f}ms p50={:.2f}ms p95={:.2f}ms p99={:.2f}ms\n",
+                     name, h.total(), h.last(), h.percentile(0.50f),
+                     h.percentile(0.95f), h.percentile(0.99f));
+}
+
+std::string formatInputLatencyReport(bool json) {
+  std::string out = json ? "{" : "";
+  for (size_t i = 0; i < INPUT_LATENCY_KIND_COUNT; ++i) {
+    if (json && i > 0)
+      out += ", ";
+    out += formatHistogram(inputLatencyKindName((eInputLatencyKind)i),
+                           g_horzaStats.inputLatency[i], json);
+  }
+  if (json)
+    out += "}";
+  return out;
+}
+
+std::string formatHorzaStatsReport(const SHorzaLiveUsage& live, bool json) {
+  const auto& st = g_horzaStats;
+  const double cacheLookups = (double)(st.tileCacheHits + st.tileCacheMisses);
+  const double hitRate = cacheLookups > 0.0 ? st.tileCacheHits / cacheLookups : 0.0;
+
+  if (json) {
+    std::string out = "{";
+    out += std::format("\"overview_open\": {}, ", live.overviewOpen ? "true" : "false");
+    out += "\"captures\": {" +
+           formatHistogram("workspace", st.workspaceCaptureMs, true) + ", " +
+           formatHistogram("background", st.backgroundCaptureMs, true) + ", " +
+           formatHistogram("leave", st.leaveCaptureMs, true) + ", " +
+           formatHistogram("prefetch", st.prefetchCaptureMs, true) +
+           std::format(", \"presented_frame\": {}, \"transit_cache_hits\": {}, "
+                       "\"reduced_levels\": {}, \"snapshot_damage_dropped\": {}, "
+                       "\"failures\": {}}}, ",
+                       st.presentedFrameCaptures, st.transitCacheHits,
+                       st.reducedLevelBuilds, st.snapshotDamageDropped,
+                       st.captureFailures);
+    out += std::format("\"tile_cache\": {{\"hits\": {}, \"misses\": {}, "
+                       "\"hit_rate\": {:.3f}, \"stores\": {}, \"evictions\": {}, "
+                       "\"entries\": {}, \"bytes\": {}}}, ",
+                       st.tileCacheHits, st.tileCacheMisses, hitRate, st.tileCacheStores,
+                       st.tileCacheEvictions, live.tileCacheEntries, live.tileCacheBytes);
+    out += std::format("\"framebuffer_bytes\": {}, ", live.framebufferBytes);
+    out += std::format("\"frames\": {{\"pumped\": {}, \"presented\": {}, "
+                       "\"rendered\": {}, ",
+                       st.framesPumped, st.framesPresented, st.framesRendered) +
+           formatHistogram("render", st.renderMs, true) + "}, ";
+    out += std::format("\"workspace_sync\": {{\"events\": {}, \"incremental\": {}, "
+                       "\"resyncs\": {}}}, ",
+                       st.workspaceSyncEvents, st.workspaceIncrementalSyncs,
+                       st.workspaceSyncs);
+    out += "\"latency\": " + formatInputLatencyReport(true);
+    out += "}";
+    return out;
+  }
+
+  std::string out;
+  out += std::format("overview open: {}\n", live.overviewOpen ? "yes" : "no");
+  out += "captures:\n";
+  out += "  " + formatHistogram("workspace", st.workspaceCaptureMs, false);
+  out += "  " + formatHistogram("background", st.backgroundCaptureMs, false);
+  out += "  " + formatHistogram("leave", st.leaveCaptureMs, false);
+  out += "  " + formatHistogram("prefetch", st.prefetchCaptureMs, false);
+  out += std::format("  from presented frame: {}\n", st.presentedFrameCaptures);
+  out += std::format("  transit from cache: {}\n", st.transitCacheHits);
+  out += std::format("  reduced levels built: {}\n", st.reducedLevelBuilds);
+  out += std::format("  damage dropped by closed snapshots: {}\n",
+                     st.snapshotDamageDropped);
+  out += std::format("  failures: {}\n", st.captureFailures);
+  out += std::format("tile cache: hits={} misses={} hit_rate={:.1f}% stores={} "
+                     "evictions={} entries={} memory={:.1f}MiB\n",
+                     st.tileCacheHits, st.tileCacheMisses, hitRate * 100.0,
+                     st.tileCacheStores, st.tileCacheEvictions, live.tileCacheEntries,
+                     live.tileCacheBytes / (1024.0 * 1024.0));
+  out += std::format("overview framebuffers: {:.1f}MiB\n",
+                     live.framebufferBytes / (1024.0 * 1024.0));
+  out += std::format("frames: pumped={} presented={} rendered={}\n", st.framesPumped,
+                     st.framesPresented, st.framesRendered);
+  out += "  " + formatHistogram("render", st.renderMs, false);
+  out += std::format("workspace sync: events={} incremental={} resyncs={}\n",
+                     st.workspaceSyncEvents, st.workspaceIncrementalSyncs,
+                     st.workspaceSyncs);
+  out += "latency:\n";
+  std::string latency = formatInputLatencyReport(false);
+  for (size_t pos = 0; pos < latency.size();) {
+    const size_t end = latency.find('\n', pos);
+    out += "  " + latency.substr(pos, end - pos) + "\n";
+    if (end == std::string::npos)
+      break;
+    pos = end + 1;
+  }
+  return out;
+}
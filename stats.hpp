@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum eInputLatencyKind : uint8_t {
+  INPUT_LATENCY_SCROLL = 0,
+  INPUT_LATENCY_DRAG_HOVER,
+  INPUT_LATENCY_WORKSPACE_DISPATCH,
+  INPUT_LATENCY_OPEN,
+  INPUT_LATENCY_KEY,
+  INPUT_LATENCY_KIND_COUNT,
+};
+
+// Fixed window of the most recent samples; percentiles follow current behaviour
+// instead of being dominated by a long session.
+class CLatencyHistogram {
+public:
+  void record(float ms);
+  void reset();
+  float percentile(float p) const;
+  uint64_t total() const { return totalSamples; }
+  float last() const;
+
+private:
+  static constexpr size_t CAPACITY = 512;
+  std::array<float, CAPACITY> samples{};
+  size_t nextSlot = 0;
+  size_t stored = 0;
+  uint64_t totalSamples = 0;
+};
+
+struct SHorzaStats {
+  std::array<CLatencyHistogram, INPUT_LATENCY_KIND_COUNT> inputLatency;
+  CLatencyHistogram workspaceCaptureMs;
+  CLatencyHistogram backgroundCaptureMs;
+  CLatencyHistogram leaveCaptureMs;
+  CLatencyHistogram prefetchCaptureMs;
+  uint64_t captureFailures = 0;
+  uint64_t presentedFrameCaptures = 0;
+  uint64_t reducedLevelBuilds = 0;
+  uint64_t snapshotDamageDropped = 0;
+  uint64_t transitCacheHits = 0;
+  uint64_t tileCacheHits = 0;
+  uint64_t tileCacheMisses = 0;
+  uint64_t tileCacheStores = 0;
+  uint64_t tileCacheEvictions = 0;
+  uint64_t framesPumped = 0;
+  uint64_t framesPresented = 0;
+  uint64_t framesRendered = 0;
+  CLatencyHistogram renderMs;
+  uint64_t workspaceSyncEvents = 0;
+  uint64_t workspaceSyncs = 0;
+  uint64_t workspaceIncrementalSyncs = 0;
+
+  void reset();
+};
+
+// Values that are read from live plugin state when a report is requested.
+struct SHorzaLiveUsage {
+  bool overviewOpen = false;
+  size_t tileCacheEntries = 0;
+  size_t tileCacheBytes = 0;
+  size_t framebufferBytes = 0;
+};
+
+inline SHorzaStats g_horzaStats;
+
+const char* inputLatencyKindName(eInputLatencyKind kind);
+std::string formatInputLatencyReport(bool json);
+std::string formatHorzaStatsReport(const SHorzaLiveUsage& live, bool json);
@@ -0,0 +1,364 @@
+// Unit tests for horza_core. Runs every case and exits non-zero on failure:
+//   horza_core_tests
+#include "core/capture_schedule.hpp"
+#include "core/config_parse.hpp"
+#include "core/layout.hpp"
+#include "core/tile_cache.hpp"
+#include "core/workspace_reconcile.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);     \
+      g_failures++;                                                            \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_NEAR(a, b, eps) CHECK(std::fabs((double)(a) - (double)(b)) <= (eps))
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+// 1000x500 monitor at half scale: 500x250 cards, 20 px gaps, card 0 centred.
+SStripLayoutParams halfScaleParams() {
+  return {.monitorW = 1000.0,
+          .monitorH = 500.0,
+          .scale = 0.5f,
+          .displayScale = 0.5f,
+          .gap = 20.0f,
+          .currentIdx = 0};
+}
+
+int hitAt(const SStripLayout& layout, int count, double x, double y) {
+  std::vector<SCardRect> rects(count);
+  for (int i = 0; i < count; ++i)
+    rects[i] = stripCardRect(layout, i);
+  return hitStripCard(layout, count, x, y,
+                      [&](int i) -> const SCardRect& { return rects[i]; });
+}
+
+void testLayout() {
+  const auto layout = computeStripLayout(halfScaleParams());
+  CHECK_NEAR(layout.tileW, 500.0, 1e-3);
+  CHECK_NEAR(layout.tileH, 250.0, 1e-3);
+  CHECK_NEAR(layout.gap, 20.0, 1e-3);
+  CHECK_NEAR(layout.step, 520.0, 1e-3);
+  CHECK_NEAR(layout.startX, 250.0, 1e-3);
+  CHECK_NEAR(layout.startY, 125.0, 1e-3);
+
+  const auto second = stripCardRect(layout, 1);
+  CHECK_NEAR(second.x, 770.0, 1e-3);
+  CHECK_NEAR(second.w, 500.0, 1e-3);
+
+  // The gap grows with the animated scale relative to the target scale.
+  auto zooming = halfScaleParams();
+  zooming.scale = 1.0f;
+  CHECK_NEAR(computeStripLayout(zooming).gap, 40.0, 1e-3);
+
+  auto shifted = halfScaleParams();
+  shifted.primaryOffset = -100.0f;
+  shifted.crossOffset = 10.0f;
+  const auto shiftedLayout = computeStripLayout(shifted);
+  CHECK_NEAR(shiftedLayout.startX, 150.0, 1e-3);
+  CHECK_NEAR(shiftedLayout.startY, 135.0, 1e-3);
+}
+
+void testHitTest() {
+  const auto layout = computeStripLayout(halfScaleParams());
+  CHECK(hitAt(layout, 3, 260.0, 200.0) == 0);
+  // Edges are inclusive.
+  CHECK(hitAt(layout, 3, 250.0, 125.0) == 0);
+  CHECK(hitAt(layout, 3, 750.0, 375.0) == 0);
+  CHECK(hitAt(layout, 3, 770.0, 200.0) == 1);
+  // The gap between card 0 and card 1, and outside the strip.
+  CHECK(hitAt(layout, 3, 760.0, 200.0) == -1);
+  CHECK(hitAt(layout, 3, 100.0, 200.0) == -1);
+  CHECK(hitAt(layout, 3, 260.0, 100.0) == -1);
+  CHECK(hitAt(layout, 3, 260.0, 400.0) == -1);
+  // Past the last card.
+  CHECK(hitAt(layout, 2, 1300.0, 200.0) == -1);
+  CHECK(hitAt(layout, 0, 260.0, 200.0) == -1);
+
+  // Off-centre cards shrink; the slot they vacate is no longer a hit.
+  auto shrinking = halfScaleParams();
+  shrinking.inactiveScale = 0.5f;
+  const auto shrunk = computeStripLayout(shrinking);
+  const auto card1 = stripCardRect(shrunk, 1);
+  CHECK_NEAR(card1.w, 250.0, 1e-3);
+  CHECK_NEAR(card1.x, 895.0, 1e-3);
+  CHECK(hitAt(shrunk, 3, 800.0, 200.0) == -1);
+  CHECK(hitAt(shrunk, 3, 900.0, 250.0) == 1);
+
+  auto vertical = halfScaleParams();
+  vertical.vertical = true;
+  const auto column = computeStripLayout(vertical);
+  CHECK_NEAR(column.step, 270.0, 1e-3);
+  CHECK(hitAt(column, 3, 500.0, 130.0) == 0);
+  CHECK(hitAt(column, 3, 500.0, 380.0) == -1); // gap
+  CHECK(hitAt(column, 3, 500.0, 400.0) == 1);
+  CHECK(hitAt(column, 3, 200.0, 130.0) == -1);
+
+  CHECK(cardRectOnScreen(stripCardRect(layout, 0), 1000.0, 500.0));
+  CHECK(!cardRectOnScreen(stripCardRect(layout, 2), 1000.0, 500.0));
+  CHECK(!cardRectOnScreen({0.0, 0.0, 1.0, 100.0}, 1000.0, 500.0));
+}
+
+void testTileCachePrune() {
+  const auto now = Clock::now();
+  const auto alive = [](int v) { return v >= 0; };
+
+  {
+    CTileCache<int> cache;
+    cache.store({0, 1}, 1, now, now - milliseconds(6000));
+    cache.store({0, 2}, 2, now, now - milliseconds(1000));
+    cache.store({0, 3}, -1, now, now);
+    CHECK(cache.prune(now, milliseconds(5000), 100, alive) == 2);
+    CHECK(cache.size() == 1);
+    CHECK(cache.find({0, 2}) != nullptr);
+  }
+
+  {
+    // LRU cap keeps the most recently used entries.
+    CTileCache<int> cache;
+    for (int i = 0; i < 5; ++i)
+      cache.store({0, i}, i, now, now - milliseconds(i));
+    CHECK(cache.prune(now, milliseconds(5000), 2, alive) == 3);
+    CHECK(cache.size() == 2);
+    CHECK(cache.find({0, 0}) != nullptr);
+    CHECK(cache.find({0, 1}) != nullptr);
+  }
+
+  {
+    // touch() refreshes recency but find() does not.
+    CTileCache<int> cache;
+    cache.store({0, 1}, 1, now, now - milliseconds(10));
+    cache.store({0, 2}, 2, now, now - milliseconds(5));
+    CHECK(cache.find({0, 1})->cachedAt == now - milliseconds(10));
+    CHECK(cache.touch({0, 1}, now) != nullptr);
+    CHECK(cache.touch({0, 9}, now) == nullptr);
+    CHECK(cache.prune(now, milliseconds(5000), 1, alive) == 1);
+    CHECK(cache.find({0, 1}) != nullptr);
+  }
+
+  {
+    // All entries tied at the cutoff: drop exactly down to the cap.
+    CTileCache<int> cache;
+    for (int i = 0; i < 4; ++i)
+      cache.store({1, i}, i, now, now);
+    CHECK(cache.prune(now, milliseconds(5000), 2, alive) == 2);
+    CHECK(cache.size() == 2);
+  }
+
+  {
+    // One strictly older entry plus ties: the older one always goes.
+    CTileCache<int> cache;
+    cache.store({0, 0}, 0, now, now - milliseconds(100));
+    for (int i = 1; i < 4; ++i)
+      cache.store({0, i}, i, now, now);
+    CHECK(cache.prune(now, milliseconds(5000), 2, alive) == 2);
+    CHECK(cache.size() == 2);
+    CHECK(cache.find({0, 0}) == nullptr);
+  }
+
+  {
+    // Monitors are separate keys; capturedAt defaults to the store time.
+    CTileCache<int> cache;
+    cache.store({0, 1}, 1, {}, now);
+    cache.store({1, 1}, 2, now - milliseconds(50), now);
+    CHECK(cache.size() == 2);
+    CHECK(cache.find({0, 1})->capturedAt == now);
+    CHECK(cache.find({1, 1})->payload == 2);
+    CHECK(cache.erase({1, 1}));
+    CHECK(!cache.erase({1, 1}));
+  }
+}
+
+void testReconcile() {
+  {
+    // Insert at the end; the centre stays on its workspace.
+    const auto plan = reconcileWorkspaceList({1, 2, 3}, {1, 2, 3, 4}, 2, 1, 1);
+    CHECK((plan.oldIndexFor == std::vector<int>{0, 1, 2, -1}));
+    CHECK(plan.currentIdx == 1);
+  }
+  {
+    // Insert in the middle shifts the centre's index.
+    const auto plan = reconcileWorkspaceList({1, 3}, {1, 2, 3}, 3, 1, 1);
+    CHECK((plan.oldIndexFor == std::vector<int>{0, -1, 1}));
+    CHECK(plan.currentIdx == 2);
+  }
+  {
+    // Removing the centre falls back to the active workspace...
+    const auto plan = reconcileWorkspaceList({1, 2, 3}, {1, 3}, 2, 3, 1);
+    CHECK((plan.oldIndexFor == std::vector<int>{0, 2}));
+    CHECK(plan.currentIdx == 1);
+  }
+  {
+    // ...and then to the old index, clamped.
+    const auto plan = reconcileWorkspaceList({1, 2, 3}, {1, 2}, 3, 7, 2);
+    CHECK(plan.currentIdx == 1);
+  }
+  {
+    // Reordered and vacated old cards map by ID.
+    const auto plan = reconcileWorkspaceList({3, 1, -1, 2}, {1, 2, 3}, 1, 1, 0);
+    CHECK((plan.oldIndexFor == std::vector<int>{1, 3, 0}));
+    CHECK(plan.currentIdx == 0);
+  }
+  {
+    const auto plan = reconcileWorkspaceList({1, 2}, {}, 1, 1, 0);
+    CHECK(plan.oldIndexFor.empty());
+    CHECK(plan.currentIdx == -1);
+  }
+
+  CStubCompositorView view;
+  view.activeByMonitor = {2, 5};
+  view.workspaces = {{.id = 3, .monitorID = 0}, {.id = 5, .monitorID = 1},
+                     {.id = 1, .monitorID = 0}, {.id = -98, .monitorID = 0}};
+  std::vector<int64_t> ids;
+  collectMonitorWorkspaceIDs(view, 0, ids);
+  CHECK((ids == std::vector<int64_t>{1, 3}));
+  CHECK(view.activeWorkspaceID(1) == 5);
+  CHECK(view.activeWorkspaceID(4) == -1);
+}
+
+void testConfigParse() {
+  bool b = false;
+  CHECK(parseStrictBool(" True ", b) && b);
+  CHECK(parseStrictBool("false", b) && !b);
+  b = true;
+  CHECK(!parseStrictBool("1", b) && b);
+  CHECK(!parseStrictBool("yes", b));
+  CHECK(!parseStrictBool("", b));
+
+  std::string out = "unchanged";
+  CHECK(parseCaptureFormat("native", out) && out == "auto");
+  CHECK(parseCaptureFormat(" ARGB8888", out) && out == "8bit");
+  CHECK(parseCaptureFormat("RGB565", out) && out == "compact");
+  CHECK(parseCaptureFormat("16bit", out) && out == "compact");
+  out = "unchanged";
+  CHECK(!parseCaptureFormat("rgba1010102", out) && out == "unchanged");
+
+  CHECK(parseCardShadowMode("Box", out) && out == "fast");
+  CHECK(parseCardShadowMode("png", out) && out == "texture");
+  CHECK(!parseCardShadowMode("blur", out) && out == "texture");
+
+  CHECK(normalizeHorzaToken("Frame-Pump") == "frame_pump");
+  CHECK(stripWrappedQuotes("\"a b\"") == "a b");
+  CHECK(stripWrappedQuotes("'x") == "'x");
+  CHECK_NEAR(clampCaptureScale(0.0f), 1.0f, 1e-6);
+  CHECK_NEAR(clampCaptureScale(0.01f), 0.05f, 1e-6);
+  CHECK_NEAR(effectiveDisplayScale(1.0f), 0.985f, 1e-6);
+  CHECK_NEAR(clampFramePumpFps(-3.0f), 0.0f, 1e-6);
+}
+
+void testCapturePicks() {
+  const auto now = Clock::now();
+  std::vector<SCardCaptureState> states(7);
+  for (int i = 0; i < 7; ++i)
+    states[i] = {.captured = true, .onScreen = true, .lastCaptureAt = now};
+  const auto stateOf = [&](int i) { return states[i]; };
+
+  CHECK(pickNearestUncapturedCard(7, 3, 3, stateOf) == -1);
+  CHECK(pickNearestUncapturedCard(7, 9, 3, stateOf) == -1);
+
+  states[3].captured = false;
+  CHECK(pickNearestUncapturedCard(7, 3, 0, stateOf) == 3);
+  states[3].captured = true;
+
+  // Equal distance prefers the lower index; off-screen cards are skipped.
+  states[1].captured = false;
+  states[5].captured = false;
+  CHECK(pickNearestUncapturedCard(7, 3, 3, stateOf) == 1);
+  states[1].onScreen = false;
+  CHECK(pickNearestUncapturedCard(7, 3, 3, stateOf) == 5);
+  CHECK(pickNearestUncapturedCard(7, 3, 1, stateOf) == -1);
+
+  for (auto& st : states)
+    st = {.captured = true, .onScreen = true, .lastCaptureAt = now};
+  // Nothing is older than one 10 fps interval yet.
+  CHECK(pickLivePreviewCard(7, 3, 2, 10.0f, now, stateOf) == -1);
+  states[2].lastCaptureAt = now - milliseconds(200);
+  states[4].lastCaptureAt = now - milliseconds(300);
+  states[0].lastCaptureAt = now - milliseconds(900); // outside the radius
+  CHECK(pickLivePreviewCard(7, 3, 2, 10.0f, now, stateOf) == 4);
+  states[4].onScreen = false;
+  CHECK(pickLivePreviewCard(7, 3, 2, 10.0f, now, stateOf) == 2);
+  CHECK(pickLivePreviewCard(7, 3, 2, 0.0f, now, stateOf) == -1);
+  CHECK(pickLivePreviewCard(7, 3, 0, 10.0f, now, stateOf) == -1);
+  CHECK(pickLivePreviewCard(1, 0, 2, 10.0f, now, stateOf) == -1);
+
+  CHECK(inCaptureRadius(3, 3, 0));
+  CHECK(!inCaptureRadius(4, 3, 0));
+  CHECK(inCaptureRadius(1, 3, 2));
+}
+
+void testCaptureBudget() {
+  CHECK_NEAR(captureBudgetForOutput(4.0f, {{.refreshHz = 144.0f}}, 0), 4.0f, 1e-4);
+  CHECK_NEAR(captureBudgetForOutput(0.0f, {{}, {}}, 0), 0.0f, 1e-6);
+  CHECK_NEAR(captureBudgetForOutput(4.0f, {{}, {}}, 5), 4.0f, 1e-6);
+
+  const std::vector<SOutputCaptureDemand> focus = {
+      {.refreshHz = 60.0f, .focused = true}, {.refreshHz = 60.0f}};
+  CHECK_NEAR(captureBudgetForOutput(4.0f, focus, 0), 8.0f / 3.0f, 1e-4);
+  CHECK_NEAR(captureBudgetForOutput(4.0f, focus, 1), 4.0f / 3.0f, 1e-4);
+
+  // Equal weight, different rates: same time per second, smaller 120 Hz slices.
+  // At equal rates the slices add up to what one output would get.
+  const std::vector<SOutputCaptureDemand> rates = {{.refreshHz = 60.0f},
+                                                   {.refreshHz = 120.0f}};
+  CHECK_NEAR(captureBudgetForOutput(4.0f, rates, 0), 4.0f, 1e-4);
+  CHECK_NEAR(captureBudgetForOutput(4.0f, rates, 1), 2.0f, 1e-4);
+
+  const std::vector<SOutputCaptureDemand> missing = {
+      {.missingCards = true}, {.focused = true, .missingCards = true}, {}};
+  CHECK_NEAR(captureBudgetForOutput(7.0f, missing, 0), 2.0f, 1e-4);
+  CHECK_NEAR(captureBudgetForOutput(7.0f, missing, 1), 4.0f, 1e-4);
+  CHECK_NEAR(captureBudgetForOutput(7.0f, missing, 2), 1.0f, 1e-4);
+}
+
+void testPrefetchPick() {
+  std::vector<int64_t> out;
+  const auto all = [](int64_t) { return true; };
+
+  pickPrefetchWorkspaces(3, {3, 1, 4, 7}, 4, [](int64_t id) { return id != 2; }, out);
+  CHECK((out == std::vector<int64_t>{4, 1, 7}));
+
+  pickPrefetchWorkspaces(3, {3, 1, 4, 7}, 2, all, out);
+  CHECK((out == std::vector<int64_t>{4, 2}));
+
+  // Workspace 0 and below are never candidates.
+  pickPrefetchWorkspaces(1, {1, 5, 5}, 4, all, out);
+  CHECK((out == std::vector<int64_t>{2, 5}));
+
+  pickPrefetchWorkspaces(3, {}, 0, all, out);
+  CHECK(out.empty());
+}
+
+} // namespace
+
+int main() {
+  testLayout();
+  testHitTest();
+  testTileCachePrune();
+  testReconcile();
+  testConfigParse();
+  testCapturePicks();
+  testCaptureBudget();
+  testPrefetchPick();
+
+  if (g_failures > 0) {
+    std::printf("%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  std::printf("all checks passed\n");
+  return 0;
+}
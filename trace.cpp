@@ -0,0 +1,92 @@
+#include "trace.hpp"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <unistd.h>
+
+void CTracer::start() {
+  if (enabled())
+    return;
+  if (!ring)
+    ring = std::make_unique<STraceEvent[]>(CAPACITY);
+  writeIdx.store(0, std::memory_order_relaxed);
+  epoch = std::chrono::steady_clock::now();
+  active.store(true, std::memory_order_release);
+}
+
+void CTracer::stop() { active.store(false, std::memory_order_release); }
+
+uint64_t CTracer::nowUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void CTracer::push(const STraceEvent& ev) {
+  if (!ring)
+    return;
+  const uint64_t idx = writeIdx.fetch_add(1, std::memory_order_relaxed);
+  ring[idx % CAPACITY] = ev;
+}
+
+void CTracer::complete(const char* name, uint64_t startUs, uint64_t durUs,
+                       const char* argName, int64_t arg) {
+  push({.name = name, .argName = argName, .arg = arg, .startUs = startUs,
+        .durUs = durUs, .phase = 'X'});
+}
+
+void CTracer::instant(const char* name, const char* argName, int64_t arg) {
+  if (!enabled())
+    return;
+  push({.name = name, .argName = argName, .arg = arg, .startUs = nowUs(),
+        .phase = 'i'});
+}
+
+size_t CTracer::recorded() const {
+  return (size_t)std::min<uint64_t>(writeIdx.load(std::memory_order_relaxed),
+                                    CAPACITY);
+}
+
+bool CTracer::dump(const std::string& path, std::string& error) const {
+  if (!ring) {
+    error = "no trace recorded";
+    return false;
+  }
+
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) {
+    error = "cannot open " + path;
+    return false;
+  }
+
+  const uint64_t end = writeIdx.load(std::memory_order_acquire);
+  const uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+  const int pid = (int)getpid();
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  for (uint64_t i = begin; i < end; ++i) {
+    const auto& ev = ring[i % CAPACITY];
+    if (!ev.name)
+      continue;
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << std::format("{{\"name\": \"{}\", \"cat\": \"horza\", \"ph\": \"{}\", "
+                       "\"ts\": {}, \"pid\": {}, \"tid\": 1",
+                       ev.name, ev.phase, ev.startUs, pid);
+    if (ev.phase == 'X')
+      out << std::format(", \"dur\": {}", ev.durUs);
+    else
+      out << ", \"s\": \"t\"";
+    if (ev.argName)
+      out << std::format(", \"args\": {{\"{}\": {}}}", ev.argName, ev.arg);
+    out << "}";
+  }
+  out << "\n]}\n";
+
+  if (!out) {
+    error = "write to " + path + " failed";
+    return false;
+  }
+  return true;
+}
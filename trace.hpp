@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Opt-in timeline tracer. Events go into a fixed ring (oldest overwritten) and
+// are exported as Chrome trace-event JSON, loadable in chrome://tracing or
+// ui.perfetto.dev. While stopped every hook is a single relaxed atomic load.
+struct STraceEvent {
+  const char* name = nullptr; // must be a string literal
+  const char* argName = nullptr;
+  int64_t arg = 0;
+  uint64_t startUs = 0;
+  uint64_t durUs = 0;
+  char phase = 'X';
+};
+
+class CTracer {
+public:
+  static constexpr size_t CAPACITY = 1U << 16;
+
+  void start();
+  void stop();
+  bool enabled() const { return active.load(std::memory_order_relaxed); }
+  uint64_t nowUs() const;
+
+  void complete(const char* name, uint64_t startUs, uint64_t durUs,
+                const char* argName = nullptr, int64_t arg = 0);
+  void instant(const char* name, const char* argName = nullptr, int64_t arg = 0);
+
+  size_t recorded() const;
+  bool dump(const std::string& path, std::string& error) const;
+
+private:
+  void push(const STraceEvent& ev);
+
+  std::atomic<bool> active{false};
+  std::atomic<uint64_t> writeIdx{0};
+  std::unique_ptr<STraceEvent[]> ring;
+  std::chrono::steady_clock::time_point epoch{};
+};
+
+inline CTracer g_horzaTracer;
+
+// Records a complete ('X') event covering the lifetime of the object.
+class CTraceSpan {
+public:
+  explicit CTraceSpan(const char* name_, const char* argName_ = nullptr,
+                      int64_t arg_ = 0) {
+    if (!g_horzaTracer.enabled())
+      return;
+    name = name_;
+    argName = argName_;
+    arg = arg_;
+    startUs = g_horzaTracer.nowUs();
+  }
+  ~CTraceSpan() {
+    if (name && g_horzaTracer.enabled())
+      g_horzaTracer.complete(name, startUs, g_horzaTracer.nowUs() - startUs,
+                             argName, arg);
+  }
+
+  CTraceSpan(const CTraceSpan&) = delete;
+  CTraceSpan& operator=(const CTraceSpan&) = delete;
+
+private:
+  const char* name = nullptr;
+  const char* argName = nullptr;
+  int64_t arg = 0;
+  uint64_t startUs = 0;
+};